@@ -0,0 +1,802 @@
+/**
+ * Author(s):           Arda T. Kersu
+ * File name:           dml_bench.c
+ * Date:                30th November 2023
+ *
+ * Description: Benchmark for the functions of "dml.h". Synthetic data frames of a configurable
+ *              size are generated, every kernel is warmed up once and then timed over a number of
+ *              repetitions, and the best and average time per processed element is reported
+ *              together with a nominal estimate of the bytes each kernel moves per element.
+ *              With -DDML_PROFILE (on both files) a further column reports the bytes the
+ *              library actually allocated per element, from the profiling counters; it shows
+ *              "-" for cases that call no instrumented function.
+ *              -DDML_FIXED_COLS=N adds the 'fixed*' kernels when the frame has N columns.
+ *
+ *              Host build (monotonic clock):
+ *                  cc -O2 -std=c99 bench/dml_bench.c dml.c -lm -o dml_bench
+ *                  ./dml_bench [rows] [cols] [repetitions]
+ *              Without arguments a sweep over several frame sizes is run. Add -fopenmp (or
+ *              -DDML_USE_PTHREADS -pthread) to measure the parallel kernels, and -march=native
+ *              to measure the widest SIMD backend of the machine.
+ *
+ *              Cortex-M build (DWT cycle counter, results in cycles instead of nanoseconds):
+ *                  define DML_BENCH_DWT, link with dml.c and call 'dmlBenchMain' from the
+ *                  firmware after retargeting 'printf' to a serial port.
+ *
+ * Disclaimer: This open-source project is provided "as is" without any warranty, expressed or implied.
+ *             The contributors and maintainers disclaim any an all unintended consequences or issues
+ *             that may arise from its use. Users are encouraged to review and understand the software's
+ *             characteristics before implementation.
+ *
+ *
+ * Copyright @ [Arda T. Kersu]
+ *
+ */
+
+#if !defined(DML_BENCH_DWT) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 199309L
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "../dml.h"
+
+#if defined(DML_BENCH_DWT)
+#define DWT_CTRL   (*(volatile uint32_t *)0xE0001000u)
+#define DWT_CYCCNT (*(volatile uint32_t *)0xE0001004u)
+#define DEMCR      (*(volatile uint32_t *)0xE000EDFCu)
+#define BENCH_UNIT "cyc"
+#else
+#define BENCH_UNIT "ns"
+#endif
+
+/* Centroids 'pairwiseDistances' compares every row with, taken from the top of the frame. */
+#define BENCH_CENTROIDS 16
+
+/* Rows per block of the '.csv' stream cases, and ring slots of the pipelined one. */
+#define BENCH_STREAM_ROWS 64
+#define BENCH_STREAM_SLOTS 4
+
+/* Capacity of the profile snapshot; larger than the number of instrumented functions. */
+#define BENCH_PROFILE_ENTRIES 64
+
+/* File written once per frame size for the 'mapBinaryFrame' case. */
+#define BENCH_BINARY_FILE "dml_bench.dmlb"
+
+/* In-memory '.csv' text read by the stream cases through 'benchReadText'. */
+typedef struct benchText
+{
+    char *text;
+    size_t len;
+    size_t pos;
+} benchText_t;
+
+/* State shared by all benchmark cases of one frame size. */
+typedef struct benchContext
+{
+    csvData_t df;
+    csvData_t normalized;
+    dmlColumnar_t columnar;
+    float *vector;
+    float *scratch;
+    dmlQuantColumn_t quantized;
+    dmlQuantStats_t quantStats;
+    benchText_t csv;
+    float *block;
+    dmlRunningStats_t *stats;
+    dmlQuantileSketch_t *sketches;
+    int binaryReady;
+#if DML_FIXED_COLS > 0
+    dmlFixedRow_t *fixedRows;
+    dmlFixedRow_t *fixedOut;
+    dmlFixedNorm_t fixedNorm;
+#endif
+    dmlRng_t rng;
+} benchContext_t;
+
+/*
+ * One timed kernel: 'run' processes 'elements(ctx)' elements and nominally moves
+ * 'bytesPerElement' each. Cases whose 'elements' is 0 do not apply to the frame and are skipped.
+ */
+typedef struct benchCase
+{
+    const char *name;
+    void (*run)(benchContext_t *ctx);
+    long (*elements)(const benchContext_t *ctx);
+    int bytesPerElement;
+} benchCase_t;
+
+static volatile float sink;
+
+static void benchClockInit(void)
+{
+#if defined(DML_BENCH_DWT)
+    DEMCR |= 1u << 24;
+    DWT_CYCCNT = 0;
+    DWT_CTRL |= 1u;
+#endif
+}
+
+/* Nanoseconds on hosts, cycles with DML_BENCH_DWT. */
+static uint64_t benchNow(void)
+{
+#if defined(DML_BENCH_DWT)
+    return DWT_CYCCNT;
+#else
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000000u + (uint64_t)now.tv_nsec;
+#endif
+}
+
+static long frameElements(const benchContext_t *ctx)
+{
+    return (long)ctx->df.rows * ctx->df.cols;
+}
+
+static long columnElements(const benchContext_t *ctx)
+{
+    return ctx->df.rows;
+}
+
+static long streamElements(const benchContext_t *ctx)
+{
+    return ctx->df.rows;
+}
+
+static int benchCentroids(const benchContext_t *ctx)
+{
+    return (ctx->df.rows < BENCH_CENTROIDS) ? ctx->df.rows : BENCH_CENTROIDS;
+}
+
+static long pairwiseElements(const benchContext_t *ctx)
+{
+    return (long)ctx->df.rows * benchCentroids(ctx) * ctx->df.cols;
+}
+
+static long binaryElements(const benchContext_t *ctx)
+{
+    return ctx->binaryReady ? frameElements(ctx) : 0;
+}
+
+#if DML_FIXED_COLS > 0
+static long fixedElements(const benchContext_t *ctx)
+{
+    return (ctx->df.cols == DML_FIXED_COLS) ? frameElements(ctx) : 0;
+}
+#endif
+
+static void benchDiscard(void *context, const char *text, size_t len)
+{
+    (void)context;
+    sink = (float)len + (float)text[0];
+}
+
+static size_t benchReadText(void *context, char *buffer, size_t size)
+{
+    benchText_t *csv = (benchText_t *)context;
+    size_t count = (csv->len - csv->pos < size) ? csv->len - csv->pos : size;
+
+    memcpy(buffer, csv->text + csv->pos, count);
+    csv->pos += count;
+    return count;
+}
+
+/* Reset the stream accumulators and rewind the '.csv' text for one stream case. */
+static void benchStreamInit(benchContext_t *ctx, dmlCsvStream_t *stream, char *buffer, int bufferSize)
+{
+    for(int col=0; col<ctx->df.cols; col++)
+    {
+        runningStatsInit(ctx->stats + col);
+        quantileSketchInit(ctx->sketches + col);
+    }
+
+    ctx->csv.pos = 0;
+    csvStreamInit(stream, benchReadText, &ctx->csv, buffer, bufferSize, 1);
+}
+
+static void benchMean(benchContext_t *ctx)
+{
+    sink = mean(&ctx->df, 0);
+}
+
+static void benchMeanColumnar(benchContext_t *ctx)
+{
+    attachColumnar(&ctx->df, &ctx->columnar);
+    sink = mean(&ctx->df, 0);
+    detachColumnar(&ctx->df);
+}
+
+static void benchMedian(benchContext_t *ctx)
+{
+    sink = median(&ctx->df, 0);
+}
+
+static void benchMedianAll(benchContext_t *ctx)
+{
+    float *medians = createFloatVector(ctx->df.cols);
+
+    medianAll(&ctx->df, NULL, ctx->df.cols, medians);
+    sink = medians[0];
+    freeVector(medians);
+}
+
+static void benchQuantile(benchContext_t *ctx)
+{
+    sink = quantile(&ctx->df, 0, 0.9f);
+}
+
+static void benchStandardDeviation(benchContext_t *ctx)
+{
+    sink = standardDeviation(&ctx->df, 0);
+}
+
+static void benchColumnStats(benchContext_t *ctx)
+{
+    dmlStats_t stats;
+
+    columnStats(&ctx->df, 0, &stats);
+    sink = stats.variance;
+}
+
+static void benchColumnStatsAll(benchContext_t *ctx)
+{
+    dmlStats_t *stats = (dmlStats_t *)malloc(sizeof(dmlStats_t) * ctx->df.cols);
+
+    columnStatsAll(&ctx->df, stats, 0);
+    sink = stats[0].variance;
+    free(stats);
+}
+
+static void benchDescribe(benchContext_t *ctx)
+{
+    dmlSummary_t *summary = (dmlSummary_t *)malloc(sizeof(dmlSummary_t) * ctx->df.cols);
+
+    describe(&ctx->df, summary);
+    sink = summary[0].median;
+    free(summary);
+}
+
+static void benchRandomDataStream(benchContext_t *ctx)
+{
+    float *stream = randomDataStreamRng(&ctx->df, ctx->df.rows, &ctx->rng);
+
+    sink = stream[0];
+    freeVector(stream);
+}
+
+static void benchScaleVector(benchContext_t *ctx)
+{
+    float *scaled = scaleVector(ctx->vector, ctx->df.rows, 0, 100, 0, 1);
+
+    sink = scaled[0];
+    freeVector(scaled);
+}
+
+static void benchScaleToUnity(benchContext_t *ctx)
+{
+    float *scaled = scaleToUnity(ctx->vector, ctx->df.rows, 0, 100);
+
+    sink = scaled[0];
+    freeVector(scaled);
+}
+
+static void benchScaleVectorInto(benchContext_t *ctx)
+{
+    scaleVectorInto(ctx->vector, ctx->scratch, ctx->df.rows, 0, 100, 0, 1);
+    sink = ctx->scratch[0];
+}
+
+static void benchSumVector(benchContext_t *ctx)
+{
+    sink = sumVector(ctx->vector, ctx->df.rows);
+}
+
+static void benchSumOfSquaresVector(benchContext_t *ctx)
+{
+    sink = sumOfSquaresVector(ctx->vector, ctx->df.rows);
+}
+
+static void benchMinMaxVector(benchContext_t *ctx)
+{
+    float minVal;
+    float maxVal;
+
+    minMaxVector(ctx->vector, ctx->df.rows, &minVal, &maxVal);
+    sink = maxVal - minVal;
+}
+
+static void benchRunningStats(benchContext_t *ctx)
+{
+    dmlRunningStats_t stats;
+
+    runningStatsInit(&stats);
+    for(int index=0; index<ctx->df.rows; index++)
+        runningStatsUpdate(&stats, ctx->vector[index]);
+    sink = stats.m2;
+}
+
+static void benchQuantileSketch(benchContext_t *ctx)
+{
+    dmlQuantileSketch_t sketch;
+
+    quantileSketchInit(&sketch);
+    for(int index=0; index<ctx->df.rows; index++)
+        quantileSketchPush(&sketch, ctx->vector[index]);
+    sink = quantileSketchQuery(&sketch, 0.5f);
+}
+
+static void benchDistancesToRows(benchContext_t *ctx)
+{
+    distancesToRows(&ctx->df, ctx->df.dataFrame[0], DML_DIST_L2SQ, ctx->scratch);
+    sink = ctx->scratch[1];
+}
+
+static void benchPairwiseDistances(benchContext_t *ctx)
+{
+    csvData_t centroids = {ctx->df.dataFrame, benchCentroids(ctx), ctx->df.cols, 0};
+    float *distances = createFloatVector(ctx->df.rows * centroids.rows);
+
+    pairwiseDistances(&ctx->df, &centroids, DML_DIST_L2SQ, distances);
+    sink = distances[0];
+    freeVector(distances);
+}
+
+static void benchTopK(benchContext_t *ctx)
+{
+    int nearest[5];
+
+    topK(ctx->vector, ctx->df.rows, 5, nearest, NULL);
+    sink = (float)nearest[0];
+}
+
+static void benchBinColumn(benchContext_t *ctx)
+{
+    dmlBins_t bins;
+
+    buildBins(&ctx->df, 0, 16, DML_BIN_QUANTILE, &bins);
+    binColumn(&ctx->df, 0, &bins, (uint8_t *)ctx->scratch);
+    sink = (float)bins.counts[0];
+    freeBins(&bins);
+}
+
+static void benchCovarianceMatrix(benchContext_t *ctx)
+{
+    float *covariance = createFloatVector(ctx->df.cols * (ctx->df.cols + 1) / 2);
+
+    covarianceMatrix(&ctx->df, covariance, 0);
+    sink = covariance[0];
+    freeVector(covariance);
+}
+
+static void benchCorrelationMatrix(benchContext_t *ctx)
+{
+    float *correlation = createFloatVector(ctx->df.cols * (ctx->df.cols + 1) / 2);
+
+    correlationMatrix(&ctx->df, correlation, 0);
+    sink = correlation[0];
+    freeVector(correlation);
+}
+
+static void benchNormalizeFrame(benchContext_t *ctx)
+{
+    dmlNormParams_t params;
+
+    normalizeFrame(&ctx->normalized, DML_NORM_ZSCORE, &params);
+    sink = params.scale[0];
+    freeNormParams(&params);
+}
+
+static void benchQuantizeColumn(benchContext_t *ctx)
+{
+    dmlQuantColumn_t column;
+
+    if(quantizeColumn(&ctx->df, 0, DML_QUANT_INT16, &column) == 0)
+    {
+        sink = column.scale;
+        freeQuantColumn(&column);
+    }
+}
+
+static void benchQuantScaleInto(benchContext_t *ctx)
+{
+    int16_t *scaled = (int16_t *)ctx->scratch;
+
+    quantScaleInto(&ctx->quantized, scaled, ctx->quantStats.min, ctx->quantStats.max, -1000, 1000);
+    sink = (float)scaled[0];
+}
+
+static void benchQuantColumnStats(benchContext_t *ctx)
+{
+    dmlQuantStats_t stats;
+
+    quantColumnStats(&ctx->quantized, &stats);
+    sink = (float)stats.variance;
+}
+
+static void benchSampleRows(benchContext_t *ctx)
+{
+    int *rows = sampleRows(&ctx->df, ctx->df.rows / 10, &ctx->rng);
+
+    sink = (float)rows[0];
+    freeVector(rows);
+}
+
+static void benchBatchIter(benchContext_t *ctx)
+{
+    dmlBatchIter_t iter;
+    dmlBatch_t batch;
+
+    batchIterInit(&iter, &ctx->df, 32, ctx->scratch, 1, &ctx->rng);
+    while(batchIterNext(&iter, &batch) > 0)
+        sink = batch.data[0];
+    batchIterFree(&iter);
+}
+
+static void benchHeadTo(benchContext_t *ctx)
+{
+    char buffer[256];
+    dmlWriter_t writer;
+
+    writerInit(&writer, benchDiscard, NULL, buffer, sizeof(buffer));
+    headTo(&writer, &ctx->df, ctx->df.rows, NULL, 0, 3);
+    writerFlush(&writer);
+}
+
+static void benchStreamStats(benchContext_t *ctx)
+{
+    char buffer[512];
+    dmlCsvStream_t stream;
+
+    benchStreamInit(ctx, &stream, buffer, sizeof(buffer));
+    streamStats(&stream, ctx->df.cols, ctx->block, BENCH_STREAM_ROWS, ctx->stats, ctx->sketches);
+    sink = ctx->stats[0].m2;
+}
+
+static void benchStreamStatsPipelined(benchContext_t *ctx)
+{
+    char buffer[512];
+    dmlCsvStream_t stream;
+
+    benchStreamInit(ctx, &stream, buffer, sizeof(buffer));
+    streamStatsPipelined(&stream, ctx->df.cols, ctx->block, BENCH_STREAM_ROWS, BENCH_STREAM_SLOTS, ctx->stats, ctx->sketches);
+    sink = ctx->stats[0].m2;
+}
+
+/* Open the file written by 'benchSetup' and touch every column, so lazily mapped pages count too. */
+static void benchMapBinaryFrame(benchContext_t *ctx)
+{
+    dmlBinaryFrame_t bin;
+    float total = 0;
+
+    (void)ctx;
+    if(mapBinaryFrame(BENCH_BINARY_FILE, &bin) != 0)
+        return;
+
+    for(int col=0; col<bin.view.cols; col++)
+        total += sumVector(columnarColumn(&bin.view, col), bin.view.rows);
+    sink = total;
+
+    unmapBinaryFrame(&bin);
+}
+
+#if DML_FIXED_COLS > 0
+static void benchFixedDistancesToRows(benchContext_t *ctx)
+{
+    dmlFixedFrame_t frame = {ctx->fixedRows, ctx->df.rows};
+
+    fixedDistancesToRows(&frame, ctx->fixedRows[0], DML_DIST_L2SQ, ctx->scratch);
+    sink = ctx->scratch[1 % ctx->df.rows];
+}
+
+static void benchFixedFrameStats(benchContext_t *ctx)
+{
+    dmlFixedFrame_t frame = {ctx->fixedRows, ctx->df.rows};
+    dmlStats_t stats[DML_FIXED_COLS];
+
+    fixedFrameStats(&frame, stats);
+    sink = stats[0].variance;
+}
+
+static void benchFixedNormalizeRow(benchContext_t *ctx)
+{
+    for(int row=0; row<ctx->df.rows; row++)
+        fixedNormalizeRow(ctx->fixedRows[row], ctx->fixedOut[row], &ctx->fixedNorm);
+    sink = ctx->fixedOut[0][0];
+}
+#endif
+
+static const benchCase_t benchCases[] =
+{
+    {"mean",                benchMean,               columnElements, 4},
+    {"mean (columnar)",     benchMeanColumnar,       columnElements, 4},
+    {"median",              benchMedian,             columnElements, 12},
+    {"medianAll",           benchMedianAll,          frameElements,  12},
+    {"quantile",            benchQuantile,           columnElements, 12},
+    {"standardDeviation",   benchStandardDeviation,  columnElements, 4},
+    {"columnStats",         benchColumnStats,        columnElements, 4},
+    {"columnStatsAll",      benchColumnStatsAll,     frameElements,  4},
+    {"describe",            benchDescribe,           frameElements,  16},
+    {"randomDataStream",    benchRandomDataStream,   streamElements, 8},
+    {"scaleVector",         benchScaleVector,        streamElements, 8},
+    {"scaleToUnity",        benchScaleToUnity,       streamElements, 8},
+    {"scaleVectorInto",     benchScaleVectorInto,    streamElements, 8},
+    {"sumVector",           benchSumVector,          streamElements, 4},
+    {"sumOfSquaresVector",  benchSumOfSquaresVector, streamElements, 4},
+    {"minMaxVector",        benchMinMaxVector,       streamElements, 4},
+    {"runningStatsUpdate",  benchRunningStats,       streamElements, 4},
+    {"quantileSketchPush",  benchQuantileSketch,     streamElements, 4},
+    {"distancesToRows",     benchDistancesToRows,    frameElements,  4},
+    {"pairwiseDistances",   benchPairwiseDistances,  pairwiseElements, 4},
+    {"topK (k=5)",          benchTopK,               streamElements, 4},
+    {"buildBins+binColumn", benchBinColumn,          columnElements, 9},
+    {"covarianceMatrix",    benchCovarianceMatrix,   frameElements,  8},
+    {"correlationMatrix",   benchCorrelationMatrix,  frameElements,  8},
+    {"normalizeFrame",      benchNormalizeFrame,     frameElements,  12},
+    {"quantizeColumn",      benchQuantizeColumn,     columnElements, 10},
+    {"quantScaleInto",      benchQuantScaleInto,     columnElements, 4},
+    {"quantColumnStats",    benchQuantColumnStats,   columnElements, 2},
+    {"sampleRows",          benchSampleRows,         columnElements, 4},
+    {"batchIterNext",       benchBatchIter,          frameElements,  8},
+    {"headTo (formatFloat)", benchHeadTo,            frameElements,  12},
+    {"streamStats",         benchStreamStats,        frameElements,  12},
+    {"streamStatsPipelined", benchStreamStatsPipelined, frameElements, 12},
+    {"mapBinaryFrame+sum",  benchMapBinaryFrame,     binaryElements, 4},
+#if DML_FIXED_COLS > 0
+    {"fixedDistancesToRows", benchFixedDistancesToRows, fixedElements, 4},
+    {"fixedFrameStats",     benchFixedFrameStats,    fixedElements,  4},
+    {"fixedNormalizeRow",   benchFixedNormalizeRow,  fixedElements,  8},
+#endif
+};
+
+/* Render the frame as '.csv' text with a header line, for the stream cases. */
+static int benchWriteCsv(benchContext_t *ctx)
+{
+    size_t capacity = (size_t)ctx->df.rows * ctx->df.cols * (DML_FLOAT_TEXT_MAX + 1) + (size_t)ctx->df.cols * 8 + 1;
+    size_t len = 0;
+
+    ctx->csv.text = (char *)malloc(capacity);
+    if(ctx->csv.text == NULL)
+        return -1;
+
+    for(int col=0; col<ctx->df.cols; col++)
+        len += (size_t)sprintf(ctx->csv.text + len, (col + 1 < ctx->df.cols) ? "c%d," : "c%d\n", col);
+
+    for(int row=0; row<ctx->df.rows; row++)
+    {
+        for(int col=0; col<ctx->df.cols; col++)
+        {
+            len += (size_t)formatFloat(ctx->csv.text + len, ctx->df.dataFrame[row][col], 3);
+            ctx->csv.text[len++] = (col + 1 < ctx->df.cols) ? ',' : '\n';
+        }
+    }
+
+    ctx->csv.len = len;
+    ctx->csv.pos = 0;
+    return 0;
+}
+
+static int benchSetup(benchContext_t *ctx, int rows, int cols)
+{
+    ctx->df.rows = rows;
+    ctx->df.cols = cols;
+    ctx->df.dataFrame = (float **)calloc((size_t)rows, sizeof(float *));
+    ctx->normalized = ctx->df;
+    ctx->normalized.dataFrame = (float **)calloc((size_t)rows, sizeof(float *));
+    ctx->vector = createFloatVector(rows);
+    ctx->scratch = createFloatVector(rows > 32 * cols ? rows : 32 * cols);
+
+    if(ctx->df.dataFrame == NULL || ctx->normalized.dataFrame == NULL || ctx->vector == NULL || ctx->scratch == NULL)
+        return -1;
+
+    rngSeed(&ctx->rng, 2023);
+
+    for(int row=0; row<rows; row++)
+    {
+        ctx->df.dataFrame[row] = createFloatVector(cols);
+        ctx->normalized.dataFrame[row] = createFloatVector(cols);
+        if(ctx->df.dataFrame[row] == NULL || ctx->normalized.dataFrame[row] == NULL)
+            return -1;
+
+        for(int col=0; col<cols; col++)
+            ctx->df.dataFrame[row][col] = rngUniform(&ctx->rng) * 100;
+        memcpy(ctx->normalized.dataFrame[row], ctx->df.dataFrame[row], sizeof(float) * cols);
+
+        ctx->vector[row] = ctx->df.dataFrame[row][0];
+    }
+
+    ctx->columnar = toColumnar(&ctx->df);
+    if(ctx->columnar.data == NULL || quantizeColumn(&ctx->df, 0, DML_QUANT_INT16, &ctx->quantized) != 0)
+        return -1;
+    quantColumnStats(&ctx->quantized, &ctx->quantStats);
+
+    ctx->block = createFloatVector(BENCH_STREAM_ROWS * BENCH_STREAM_SLOTS * cols);
+    ctx->stats = (dmlRunningStats_t *)malloc(sizeof(dmlRunningStats_t) * cols);
+    ctx->sketches = (dmlQuantileSketch_t *)malloc(sizeof(dmlQuantileSketch_t) * cols);
+    if(ctx->block == NULL || ctx->stats == NULL || ctx->sketches == NULL || benchWriteCsv(ctx) != 0)
+        return -1;
+
+#if defined(DML_BENCH_DWT)
+    ctx->binaryReady = 0;
+#else
+    ctx->binaryReady = (writeBinaryFrame(&ctx->df, BENCH_BINARY_FILE, 1) == 0);
+#endif
+
+#if DML_FIXED_COLS > 0
+    ctx->fixedRows = NULL;
+    ctx->fixedOut = NULL;
+    if(cols == DML_FIXED_COLS)
+    {
+        dmlNormParams_t params;
+
+        ctx->fixedRows = (dmlFixedRow_t *)malloc(sizeof(dmlFixedRow_t) * rows);
+        ctx->fixedOut = (dmlFixedRow_t *)malloc(sizeof(dmlFixedRow_t) * rows);
+        if(ctx->fixedRows == NULL || ctx->fixedOut == NULL || normalizeFrame(&ctx->normalized, DML_NORM_ZSCORE, &params) != 0)
+            return -1;
+
+        fixedNormFromParams(&params, &ctx->fixedNorm);
+        freeNormParams(&params);
+
+        for(int row=0; row<rows; row++)
+            memcpy(ctx->fixedRows[row], ctx->df.dataFrame[row], sizeof(dmlFixedRow_t));
+    }
+#endif
+
+    return 0;
+}
+
+static void benchTeardown(benchContext_t *ctx)
+{
+    for(int row=0; row<ctx->df.rows; row++)
+    {
+        freeVector(ctx->normalized.dataFrame[row]);
+        freeVector(ctx->df.dataFrame[row]);
+    }
+    free(ctx->normalized.dataFrame);
+    free(ctx->df.dataFrame);
+    freeVector(ctx->vector);
+    freeVector(ctx->scratch);
+    freeColumnar(&ctx->columnar);
+    freeQuantColumn(&ctx->quantized);
+    freeVector(ctx->block);
+    free(ctx->stats);
+    free(ctx->sketches);
+    free(ctx->csv.text);
+    if(ctx->binaryReady)
+        remove(BENCH_BINARY_FILE);
+#if DML_FIXED_COLS > 0
+    free(ctx->fixedRows);
+    free(ctx->fixedOut);
+#endif
+}
+
+/*
+ * Bytes allocated by instrumented library functions since the last 'profileReset', or -1
+ * if none of them ran (the case then has no measurement, not a zero one).
+ */
+static double benchAllocatedBytes(void)
+{
+    dmlProfileEntry_t entries[BENCH_PROFILE_ENTRIES];
+    int count = profileSnapshot(entries, BENCH_PROFILE_ENTRIES);
+    unsigned long calls = 0;
+    uint64_t total = 0;
+
+    for(int entry=0; entry<count; entry++)
+    {
+        calls += entries[entry].calls;
+        total += entries[entry].bytes;
+    }
+
+    return (calls > 0) ? (double)total : -1;
+}
+
+static void benchFrame(int rows, int cols, int repetitions)
+{
+    benchContext_t ctx;
+
+    if(benchSetup(&ctx, rows, cols) != 0)
+    {
+        printf("*** could not allocate a %d x %d frame ***\n", rows, cols);
+        return;
+    }
+
+    printf("*** ========== %d ROWS x %d COLS, %d REPS, SIMD: %s ========== ***\n", rows, cols, repetitions, simdBackend());
+#if defined(DML_PROFILE)
+    printf("%-22s %14s %14s %15s %14s\n", "kernel", "best " BENCH_UNIT "/elem", "avg " BENCH_UNIT "/elem", "nominal B/elem", "alloc B/elem");
+#else
+    printf("%-22s %14s %14s %15s\n", "kernel", "best " BENCH_UNIT "/elem", "avg " BENCH_UNIT "/elem", "nominal B/elem");
+#endif
+
+    for(size_t index=0; index<sizeof(benchCases)/sizeof(benchCases[0]); index++)
+    {
+        const benchCase_t *bench = benchCases + index;
+        double elements = (double)bench->elements(&ctx);
+        uint64_t best = 0;
+        uint64_t total = 0;
+        double allocated;
+
+        if(elements <= 0)
+            continue;
+
+        // The warm-up run also measures what the library allocates per run.
+        profileReset();
+        bench->run(&ctx);
+        allocated = benchAllocatedBytes();
+
+        for(int rep=0; rep<repetitions; rep++)
+        {
+            uint64_t start = benchNow();
+            uint64_t elapsed;
+
+            bench->run(&ctx);
+            elapsed = benchNow() - start;
+
+            total += elapsed;
+            if(rep == 0 || elapsed < best)
+                best = elapsed;
+        }
+
+#if defined(DML_PROFILE)
+        printf("%-22s %14.3f %14.3f %15d ", bench->name, (double)best / elements,
+               (double)total / repetitions / elements, bench->bytesPerElement);
+        if(allocated < 0)
+            printf("%14s\n", "-");
+        else
+            printf("%14.3f\n", allocated / elements);
+#else
+        (void)allocated;
+        printf("%-22s %14.3f %14.3f %15d\n", bench->name, (double)best / elements,
+               (double)total / repetitions / elements, bench->bytesPerElement);
+#endif
+    }
+
+    benchTeardown(&ctx);
+}
+
+/**
+ * @brief Run the benchmark; 'argv' may hold rows, columns and repetitions.
+ */
+int dmlBenchMain(int argc, char **argv)
+{
+#if defined(DML_BENCH_DWT)
+    static const int sweepRows[] = {64, 256, 1024};
+#else
+    static const int sweepRows[] = {1000, 100000, 1000000};
+#endif
+    int rows = (argc > 2) ? atoi(argv[1]) : sweepRows[0];
+    int cols = (argc > 2) ? atoi(argv[2]) : ((argc > 1) ? atoi(argv[1]) : 8);
+    int repetitions = (argc > 3) ? atoi(argv[3]) : 5;
+
+    // Every case reads at least one row and one column, so an empty frame is rejected here.
+    if(rows < 1 || cols < 1)
+    {
+        fprintf(stderr, "usage: %s [rows cols [repetitions]] | [cols]; rows and cols must be at least 1\n", (argc > 0) ? argv[0] : "dml_bench");
+        return 1;
+    }
+
+    benchClockInit();
+
+    if(repetitions < 1)
+        repetitions = 1;
+
+    if(argc > 2)
+    {
+        benchFrame(rows, cols, repetitions);
+        return 0;
+    }
+
+    for(size_t index=0; index<sizeof(sweepRows)/sizeof(sweepRows[0]); index++)
+        benchFrame(sweepRows[index], cols, repetitions);
+
+    return 0;
+}
+
+#if !defined(DML_BENCH_DWT)
+int main(int argc, char **argv)
+{
+    return dmlBenchMain(argc, argv);
+}
+#endif
@@ -19,11 +19,346 @@
  *
  */
 
+/* 'clock_gettime' for the DML_PROFILE timers on POSIX hosts, which strict C99 hides. */
+#if defined(DML_PROFILE) && !defined(_POSIX_C_SOURCE) && (defined(__unix__) || defined(__APPLE__))
+#define _POSIX_C_SOURCE 199309L
+#endif
+
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <math.h>
 #include <time.h>
 #include "dml.h"
 
+/*
+ * Threading backend of the parallel statistics: OpenMP when the compiler has it enabled,
+ * POSIX threads with DML_USE_PTHREADS, and a serial loop otherwise.
+ */
+#if defined(_OPENMP) && !defined(DML_NO_THREADS)
+#include <omp.h>
+#define DML_THREADS_OPENMP 1
+#elif defined(DML_USE_PTHREADS) && !defined(DML_NO_THREADS)
+#include <pthread.h>
+#define DML_THREADS_PTHREAD 1
+#endif
+
+/* The loader pipeline ('pipelineBlocks') runs its producer on a POSIX thread whatever the backend above. */
+#if defined(DML_USE_PTHREADS) && !defined(DML_NO_THREADS)
+#include <pthread.h>
+#define DML_PIPELINE_PTHREAD 1
+#endif
+
+#if !defined(DML_NO_MMAP) && (defined(__unix__) || defined(__APPLE__))
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define DML_HAVE_MMAP 1
+#endif
+
+/*
+ * SIMD backend of the vector kernels, picked at compile time from the target flags.
+ * Define DML_NO_SIMD to force the portable scalar loops, or DML_USE_CMSIS_DSP to route
+ * the kernels through ARM CMSIS-DSP on Cortex-M parts.
+ */
+#if !defined(DML_NO_SIMD) && defined(DML_USE_CMSIS_DSP)
+#include "arm_math.h"
+#define DML_SIMD_CMSIS 1
+#elif !defined(DML_NO_SIMD) && defined(__AVX__)
+#include <immintrin.h>
+#define DML_SIMD_AVX 1
+#define DML_SIMD_SSE 1
+#elif !defined(DML_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64))
+#include <emmintrin.h>
+#define DML_SIMD_SSE 1
+#elif !defined(DML_NO_SIMD) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#define DML_SIMD_NEON 1
+#endif
+
+
+/*
+ * Instrumentation of the public functions, compiled in with DML_PROFILE. Every instrumented
+ * function opens a 'profileFrame_t' with DML_PROFILE_BEGIN and closes it with
+ * DML_PROFILE_END before it returns; without DML_PROFILE both expand to nothing. The clock is
+ * the DWT cycle counter on Cortex-M3 and above, 'clock_gettime(CLOCK_MONOTONIC)' on POSIX
+ * hosts and 'clock' elsewhere.
+ */
+#if defined(DML_PROFILE)
+#if defined(__ARM_ARCH_PROFILE) && (__ARM_ARCH_PROFILE == 'M') && (__ARM_ARCH >= 7)
+#define DML_PROFILE_DWT 1
+#define DML_DWT_CTRL   (*(volatile uint32_t *)0xE0001000u)
+#define DML_DWT_CYCCNT (*(volatile uint32_t *)0xE0001004u)
+#define DML_DEMCR      (*(volatile uint32_t *)0xE000EDFCu)
+#endif
+
+enum
+{
+    DML_PROF_MEAN,
+    DML_PROF_MEDIAN,
+    DML_PROF_QUANTILE,
+    DML_PROF_MEDIAN_ALL,
+    DML_PROF_QUANTILE_MATRIX,
+    DML_PROF_COLUMN_STATS,
+    DML_PROF_COLUMN_STATS_ALL,
+    DML_PROF_DESCRIBE,
+    DML_PROF_RANDOM_DATA_STREAM,
+    DML_PROF_SAMPLE_ROWS,
+    DML_PROF_SUM_VECTOR,
+    DML_PROF_SUM_OF_SQUARES_VECTOR,
+    DML_PROF_MIN_MAX_VECTOR,
+    DML_PROF_SCALE_TO_UNITY_INTO,
+    DML_PROF_SCALE_VECTOR_INTO,
+    DML_PROF_DISTANCES_TO_ROWS,
+    DML_PROF_PAIRWISE_DISTANCES,
+    DML_PROF_TOP_K,
+    DML_PROF_NORMALIZE_FRAME,
+    DML_PROF_APPLY_NORMALIZATION,
+    DML_PROF_TO_COLUMNAR,
+    DML_PROF_BUILD_BINS,
+    DML_PROF_BIN_COLUMN,
+    DML_PROF_COVARIANCE_MATRIX,
+    DML_PROF_CORRELATION_MATRIX,
+    DML_PROF_STREAM_STATS,
+    DML_PROF_STREAM_STATS_PIPELINED,
+    DML_PROF_QUANT_COLUMN_STATS,
+    DML_PROF_QUANTIZE_COLUMN,
+    DML_PROF_MAP_BINARY_FRAME,
+    DML_PROF_COUNT
+};
+
+static dmlProfileEntry_t profileTable[DML_PROF_COUNT] =
+{
+    {"mean", 0, 0, 0, 0},
+    {"median", 0, 0, 0, 0},
+    {"quantile", 0, 0, 0, 0},
+    {"medianAll", 0, 0, 0, 0},
+    {"quantileMatrix", 0, 0, 0, 0},
+    {"columnStats", 0, 0, 0, 0},
+    {"columnStatsAll", 0, 0, 0, 0},
+    {"describe", 0, 0, 0, 0},
+    {"randomDataStream", 0, 0, 0, 0},
+    {"sampleRows", 0, 0, 0, 0},
+    {"sumVector", 0, 0, 0, 0},
+    {"sumOfSquaresVector", 0, 0, 0, 0},
+    {"minMaxVector", 0, 0, 0, 0},
+    {"scaleToUnityInto", 0, 0, 0, 0},
+    {"scaleVectorInto", 0, 0, 0, 0},
+    {"distancesToRows", 0, 0, 0, 0},
+    {"pairwiseDistances", 0, 0, 0, 0},
+    {"topK", 0, 0, 0, 0},
+    {"normalizeFrame", 0, 0, 0, 0},
+    {"applyNormalization", 0, 0, 0, 0},
+    {"toColumnar", 0, 0, 0, 0},
+    {"buildBins", 0, 0, 0, 0},
+    {"binColumn", 0, 0, 0, 0},
+    {"covarianceMatrix", 0, 0, 0, 0},
+    {"correlationMatrix", 0, 0, 0, 0},
+    {"streamStats", 0, 0, 0, 0},
+    {"streamStatsPipelined", 0, 0, 0, 0},
+    {"quantColumnStats", 0, 0, 0, 0},
+    {"quantizeColumn", 0, 0, 0, 0},
+    {"mapBinaryFrame", 0, 0, 0, 0}
+};
+
+/* Innermost instrumented function currently running; its entry is charged for allocations. */
+static int activeProfile = -1;
+
+typedef struct profileFrame
+{
+    int id;
+    int previous;
+    uint64_t start;
+} profileFrame_t;
+
+static uint64_t profileNow(void)
+{
+#if defined(DML_PROFILE_DWT)
+    static int counterEnabled = 0;
+
+    if(!counterEnabled)
+    {
+        DML_DEMCR |= 1u << 24;
+        DML_DWT_CTRL |= 1u;
+        counterEnabled = 1;
+    }
+
+    return DML_DWT_CYCCNT;
+#elif defined(CLOCK_MONOTONIC)
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000000u + (uint64_t)now.tv_nsec;
+#else
+    return (uint64_t)clock() * (1000000000u / CLOCKS_PER_SEC);
+#endif
+}
+
+static void profileEnter(profileFrame_t *frame, int id, uint64_t elements)
+{
+    profileTable[id].calls++;
+    profileTable[id].elements += elements;
+    frame->id = id;
+    frame->previous = activeProfile;
+    activeProfile = id;
+    frame->start = profileNow();
+}
+
+static void profileLeave(const profileFrame_t *frame)
+{
+#if defined(DML_PROFILE_DWT)
+    profileTable[frame->id].ticks += (uint32_t)((uint32_t)profileNow() - (uint32_t)frame->start);
+#else
+    profileTable[frame->id].ticks += profileNow() - frame->start;
+#endif
+    activeProfile = frame->previous;
+}
+
+#define DML_PROFILE_BEGIN(id, n) profileFrame_t profileFrame; profileEnter(&profileFrame, (id), (uint64_t)(n))
+#define DML_PROFILE_ELEMENTS(n) (profileTable[profileFrame.id].elements += (uint64_t)(n))
+#define DML_PROFILE_END() profileLeave(&profileFrame)
+#else
+#define DML_PROFILE_BEGIN(id, n)
+#define DML_PROFILE_ELEMENTS(n)
+#define DML_PROFILE_END()
+#endif
+
+/*
+ * Allocator used by every allocating function of the library, see 'setAllocator'. With
+ * DML_NO_HEAP defined the default serves requests from a static DML_STATIC_HEAP_SIZE
+ * byte arena and the library never references malloc or free.
+ */
+#if defined(DML_NO_HEAP)
+static union
+{
+    unsigned char bytes[DML_STATIC_HEAP_SIZE];
+    size_t alignment;
+} staticHeap;
+static dmlArena_t staticHeapArena = {staticHeap.bytes, DML_STATIC_HEAP_SIZE, 0};
+#else
+static void *heapAlloc(void *context, size_t size)
+{
+    (void)context;
+    return malloc(size);
+}
+
+static void heapRelease(void *context, void *block)
+{
+    (void)context;
+    free(block);
+}
+#endif
+
+static void *arenaAllocAdapter(void *context, size_t size)
+{
+    return arenaAlloc((dmlArena_t *)context, size);
+}
+
+static void arenaReleaseAdapter(void *context, void *block)
+{
+    arenaFree((dmlArena_t *)context, block);
+}
+
+#if defined(DML_NO_HEAP)
+static const dmlAllocator_t defaultAllocator = {arenaAllocAdapter, arenaReleaseAdapter, &staticHeapArena};
+#else
+static const dmlAllocator_t defaultAllocator = {heapAlloc, heapRelease, NULL};
+#endif
+
+static dmlAllocator_t currentAllocator = {NULL, NULL, NULL};
+
+static void *dmlAlloc(size_t size)
+{
+    const dmlAllocator_t *allocator = (currentAllocator.alloc != NULL) ? &currentAllocator : &defaultAllocator;
+
+#if defined(DML_PROFILE)
+    if(activeProfile >= 0)
+        profileTable[activeProfile].bytes += size;
+#endif
+
+    return allocator->alloc(allocator->context, size > 0 ? size : 1);
+}
+
+static void dmlFree(void *block)
+{
+    const dmlAllocator_t *allocator = (currentAllocator.alloc != NULL) ? &currentAllocator : &defaultAllocator;
+
+    if(block != NULL)
+        allocator->release(allocator->context, block);
+}
+
+/*
+ * Frames that currently have a columnar view attached through 'attachColumnar'. The column
+ * kernels below look their frame up here and read the contiguous copy when there is one.
+ */
+static struct
+{
+    const csvData_t *df;
+    const dmlColumnar_t *view;
+} attachedColumnar[DML_MAX_COLUMNAR_VIEWS];
+
+static const dmlColumnar_t *findColumnar(const csvData_t *df)
+{
+    for(int slot=0; slot<DML_MAX_COLUMNAR_VIEWS; slot++)
+    {
+        if(attachedColumnar[slot].df == df)
+            return attachedColumnar[slot].view;
+    }
+
+    return NULL;
+}
+
+/*
+ * Frames that currently have a statistics cache attached through 'attachStatsCache'. The
+ * column statistics below answer from it once a column has been computed.
+ */
+static struct
+{
+    const csvData_t *df;
+    dmlStatsCache_t *cache;
+} attachedStatsCache[DML_MAX_STATS_CACHES];
+
+/* Bits of 'dmlStatsCache_t.valid'. */
+#define DML_CACHE_MOMENTS 1u
+#define DML_CACHE_SORTED  2u
+
+static dmlStatsCache_t *findStatsCache(const csvData_t *df)
+{
+    for(int slot=0; slot<DML_MAX_STATS_CACHES; slot++)
+    {
+        if(attachedStatsCache[slot].df == df)
+            return attachedStatsCache[slot].cache;
+    }
+
+    return NULL;
+}
+
+/**
+ * @brief Copy column 'col' of 'df' into the contiguous buffer 'dst' of 'df->rows' floats.
+ */
+static void gatherColumn(csvData_t *df, int col, float *dst)
+{
+    const dmlColumnar_t *view = findColumnar(df);
+
+    if(view != NULL)
+    {
+        memcpy(dst, view->data + (long)col * view->stride, sizeof(float) * view->rows);
+        return;
+    }
+
+    for(int row=0; row<df->rows; row++)
+        *(dst + row) = df->dataFrame[row][col];
+}
+
+/**
+ * @brief Element ('row', 'col') of 'df', read through 'view' when one is attached (see 'findColumnar').
+ */
+static float frameValue(const csvData_t *df, const dmlColumnar_t *view, int row, int col)
+{
+    return (view != NULL) ? view->data[(long)col * view->stride + row] : df->dataFrame[row][col];
+}
+
 
 /**
  * @brief Display the top rows of a '.csv' file.
@@ -31,11 +366,13 @@
  * This function displays the top rows of the provided tabular data structure in 'df'.
  *
  * @param df        A pointer to the '.csv' file data structure.
- * @param lines     The number of rows to display from the top of the data.
+ * @param lines     The number of rows to display from the top of the data. It is
+ *                  clamped to the number of rows in 'df'.
  *
  * @note            The 'df' itself is not the tabular structure, it is 'df->dataFrame'.
                     'df' is a more complex structure that stores the number of rows
                     and columns, as well as the size of the data frame 'df->dataFrame'.
+ *                  See 'headTo' for a buffered variant that does not use 'printf'.
 
  *
  * @code
@@ -46,12 +383,17 @@
  */
 void head(csvData_t *df, int lines)
 {
+    const dmlColumnar_t *view = findColumnar(df);
+
+    if(lines > df->rows)
+        lines = df->rows;
+
     printf("*** ================ TOP %d ROWS ================ ***\n", lines);
     for(int row=0; row<lines; row++)
     {
         for(int col=0; col<df->cols; col++)
         {
-            printf("%10.3f\t", df->dataFrame[row][col]);
+            printf("%10.3f\t", frameValue(df, view, row, col));
         }
         puts(" ");
     }
@@ -64,11 +406,13 @@ void head(csvData_t *df, int lines)
  * This function displays the bottom rows of the provided tabular data structure 'df'.
  *
  * @param df        A pointer to the '.csv' file data structure.
- * @param lines     The number of rows to display from the top of the data.
+ * @param lines     The number of rows to display from the bottom of the data. It is
+ *                  clamped to the number of rows in 'df'.
  *
  * @note            The 'df' itself is not the tabular structure, it is 'df->dataFrame'.
                     'df' is a more complex structure that stores the number of rows
                     and columns, as well as the size of the data frame 'df->dataFrame'.
+ *                  See 'tailTo' for a buffered variant that does not use 'printf'.
  *
  * @code
  *   // Example usage:
@@ -78,12 +422,17 @@ void head(csvData_t *df, int lines)
  */
 void tail(csvData_t *df, int lines)
 {
+    const dmlColumnar_t *view = findColumnar(df);
+
+    if(lines > df->rows)
+        lines = df->rows;
+
     printf("*** ================ BOTTOM %d ROWS ================ ***\n", lines);
     for(int row=df->rows-1; row>df->rows-lines-1; row--)
     {
         for(int col=0; col<df->cols; col++)
         {
-            printf("%10.2f ", df->dataFrame[row][col]);
+            printf("%10.2f ", frameValue(df, view, row, col));
         }
         puts(" ");
     }
@@ -91,320 +440,6257 @@ void tail(csvData_t *df, int lines)
 }
 
 /**
- * @brief Generate a random data stream from a '.csv' file.
+ * @brief Write callback for 'writerInit' that writes to a stdio 'FILE *' context.
  *
- * This function generates a random data stream by sampling 'numOfData' values
- * from the provided '.csv' file. The sampled values are stored in a dynamically
- * allocated float array.
- *
- * @param df        A pointer to the '.csv' file data structure.
- * @param numOfData The number of data points to sample.
- *
- * @return A pointer to a dynamically allocated float array containing the
- *         sampled data points. The caller is responsible for freeing the memory
- *         allocated for the array when it is no longer needed.
+ * @param context The 'FILE *' to write to, e.g. 'stdout'.
+ * @param text    A pointer to the bytes to write.
+ * @param len     The number of bytes to write.
+ */
+void writeToFile(void *context, const char *text, size_t len)
+{
+    fwrite(text, 1, len, (FILE *)context);
+}
+
+/**
+ * @brief Prepare a buffered text writer that flushes through a user callback.
  *
- * @note The '.csv' file should contain numerical data accessible via 'dataFrame'.
- *       The function uses the 'rand' function to select random indices within the
- *       dimensions of the data structure to sample values.
+ * Output is collected in the caller's fixed buffer and handed to 'write' only when it is
+ * full or on 'writerFlush', so a UART driver sees a few large writes instead of one call
+ * per character, and no stdio is involved.
  *
- * @warning The caller is responsible for freeing the memory allocated for the
- *          returned array using the 'free' function to prevent memory leaks.
+ * @param writer     A pointer to the writer to initialise.
+ * @param write      The callback receiving every full buffer, e.g. 'writeToFile'.
+ * @param context    The opaque pointer passed to 'write'.
+ * @param buffer     A pointer to the caller's output buffer.
+ * @param bufferSize The capacity of 'buffer' in bytes; at least 1.
  *
  * @code
  *   // Example usage:
- *   csvData_t data = loadCsv(FILE); // Assuming the file has been loaded successfully.
- *   int numOfDataPoints = 10;
- *   float *dataStream = randomDataStream(&data, numOfDataPoints);
- *   // Use the dataStream...
- *   free(dataStream); // Free the allocated memory when done.
+ *   char text[64];
+ *   dmlWriter_t writer;
+ *   writerInit(&writer, uartWrite, &uart0, text, sizeof(text));
+ *   headTo(&writer, &data, 5, NULL, 0, 3);
+ *   writerFlush(&writer);
  * @endcode
  */
-float *randomDataStream(csvData_t *df, int numOfData)
+void writerInit(dmlWriter_t *writer, dmlWriteFn write, void *context, char *buffer, int bufferSize)
 {
-    float *stream = (float *)malloc(sizeof(float) * numOfData);
-
-    srand(time(NULL));
-
-    for(int num=0; num<numOfData; num++)
-    {
-        int xIndex = rand() % df->rows;
-        int yIndex = rand() % df->cols;
+    writer->write = write;
+    writer->context = context;
+    writer->buffer = buffer;
+    writer->bufferSize = bufferSize;
+    writer->used = 0;
+}
 
-        *(stream + num) = df->dataFrame[xIndex][yIndex];
-    }
+/**
+ * @brief Hand everything buffered so far to the writer's callback.
+ *
+ * @param writer A pointer to an initialised writer.
+ */
+void writerFlush(dmlWriter_t *writer)
+{
+    if(writer->used > 0)
+        writer->write(writer->context, writer->buffer, (size_t)writer->used);
 
-    return stream;
+    writer->used = 0;
 }
 
 /**
- * @brief Create a dynamically allocated float vector.
- *
- * This function allocates memory for a float vector of the specified length 'len'
- * and returns a pointer to the allocated memory. The caller is responsible for
- * freeing the memory when it is no longer needed.
- *
- * @param len The length of the float vector to create.
- *
- * @return A pointer to the dynamically allocated float vector.
- *
- * @warning The caller must free the memory allocated for the vector using the 'free' function
- *          to prevent memory leaks when it is no longer needed.
+ * @brief Append 'len' bytes of text to a buffered writer.
  *
- * @code
- *   // Example usage:
- *   int vectorLength = 10;
- *   float *dataVector = createFloatVector(vectorLength);
- *   // Use the 'dataVector'...
- *   free(dataVector); // Free the allocated memory when done.
- * @endcode
+ * @param writer A pointer to an initialised writer.
+ * @param text   A pointer to the text to append.
+ * @param len    The number of bytes to append.
  */
-float *createFloatVector(int len)
+void writerPut(dmlWriter_t *writer, const char *text, int len)
 {
-    float *vector = (float *)malloc(sizeof(float) * len);
+    for(int index=0; index<len; index++)
+    {
+        if(writer->used == writer->bufferSize)
+            writerFlush(writer);
 
-    return vector;
+        writer->buffer[writer->used++] = text[index];
+    }
+}
+
+static int formatFixed(char *out, float value, int decimals)
+{
+    static const uint32_t powers[] = {1, 10, 100, 1000, 10000, 100000, 1000000};
+    char digits[10];
+    uint32_t integral = (uint32_t)value;
+    uint32_t fractional = (uint32_t)((value - (float)integral) * (float)powers[decimals] + 0.5f);
+    int len = 0;
+    int count = 0;
+
+    if(fractional >= powers[decimals])
+    {
+        integral++;
+        fractional -= powers[decimals];
+    }
+
+    do
+    {
+        digits[count++] = (char)('0' + integral % 10);
+        integral /= 10;
+    } while(integral > 0);
+
+    while(count > 0)
+        out[len++] = digits[--count];
+
+    if(decimals > 0)
+    {
+        out[len++] = '.';
+        for(int place=decimals-1; place>=0; place--)
+        {
+            out[len + place] = (char)('0' + fractional % 10);
+            fractional /= 10;
+        }
+        len += decimals;
+    }
+
+    return len;
 }
 
 /**
- * @brief Calculate the mean of a specific column in a '.csv' file.
- *
- * This function calculates the mean of the values in the specified
- * column of the provided '.csv' file data structure 'df->dataFrame'.
- *
- * @param df  A pointer to the '.csv' file data structure.
- * @param col The column index for which to calculate the mean.
+ * @brief Convert a float to decimal text without 'printf'.
  *
- * @return The mean value of the specified column.
+ * Values below 1e9 in magnitude are written in fixed notation with 'decimals' digits after
+ * the point (like "%.*f"); larger ones in scientific notation (like "%.*e"). Only integer
+ * arithmetic, one float multiplication and, in scientific notation, one division by a
+ * tabulated power of ten are used per value, which keeps the routine cheap on soft-float
+ * targets.
  *
- * @note The '.csv' file should contain numerical data accessible via 'dataFrame'.
- *       The function iterates through all rows of the column and computes the mean.
+ * @param out      A pointer to at least DML_FLOAT_TEXT_MAX bytes receiving the text; it is
+ *                 not NUL-terminated.
+ * @param value    The value to convert.
+ * @param decimals The number of digits after the point, clamped to [0, 6].
  *
- * @code
- *   // Example usage:
- *   csvData_t data = loadCsv(FILE); // Assuming the file has been loaded successfully.
- *   int targetColumn = 2; // The column for which to calculate the mean.
- *   float columnMean = mean(&data, targetColumn);
- *   // Use the 'columnMean'...
- * @endcode
+ * @return The number of bytes written to 'out'.
  */
-float mean(csvData_t *df, int col)
+int formatFloat(char *out, float value, int decimals)
 {
-    float sum = 0;
+    static const float tens[] = {1e9f, 1e10f, 1e11f, 1e12f, 1e13f, 1e14f, 1e15f, 1e16f, 1e17f, 1e18f,
+                                 1e19f, 1e20f, 1e21f, 1e22f, 1e23f, 1e24f, 1e25f, 1e26f, 1e27f, 1e28f,
+                                 1e29f, 1e30f, 1e31f, 1e32f, 1e33f, 1e34f, 1e35f, 1e36f, 1e37f, 1e38f};
+    int len = 0;
+    int mantissaLen;
 
-    for(int row=0; row<df->rows; row++)
+    if(decimals < 0)
+        decimals = 0;
+    if(decimals > 6)
+        decimals = 6;
+
+    if(value != value)
+    {
+        memcpy(out, "nan", 3);
+        return 3;
+    }
+
+    if(value < 0)
+    {
+        out[len++] = '-';
+        value = -value;
+    }
+
+    if(value > 3.4028235e38f)
+    {
+        memcpy(out + len, "inf", 3);
+        return len + 3;
+    }
+
+    if(value < 1e9f)
+        return len + formatFixed(out + len, value, decimals);
+
+    int exponent = 9;
+
+    while(exponent < 38 && value >= tens[exponent - 8])
+        exponent++;
+
+    value /= tens[exponent - 9];
+    mantissaLen = formatFixed(out + len, value, decimals);
+
+    // A mantissa just below 10 can round up to "10.0..."; write it as "1.0..." one decade up.
+    if(mantissaLen > decimals + (decimals > 0) + 1)
     {
-        sum += df->dataFrame[row][col];
+        mantissaLen = formatFixed(out + len, value / 10, decimals);
+        exponent++;
     }
 
-    return (sum / (float)df->rows);
+    len += mantissaLen;
+    out[len++] = 'e';
+    out[len++] = '+';
+    out[len++] = (char)('0' + exponent / 10);
+    out[len++] = (char)('0' + exponent % 10);
+
+    return len;
 }
 
 /**
- * @brief Compare two float values for sorting purposes.
- *
- * This function is used as a comparison function for sorting float values in ascending order.
- * It compares two float values pointed to by 'a' and 'b'.
- *
- * @param a A pointer to the first float value to compare.
- * @param b A pointer to the second float value to compare.
- *
- * @return An integer value:
- *         - Less than 0 if the value pointed to by 'a' is less than the value pointed to by 'b'.
- *         - 0 if the values are equal.
- *         - Greater than 0 if the value pointed to by 'a' is greater than the value pointed to by 'b'.
- *
- * @note This function is designed to be used with sorting functions like 'qsort'.
- *       It allows sorting an array of float values in ascending order.
+ * @brief Append a float to a buffered writer, right-aligned in a field of 'width' characters.
  *
- * @code
- *   // Example usage with qsort:
- *   float values[] = {3.5, 1.2, 2.8, 0.9};
- *   int numValues = sizeof(values) / sizeof(values[0]);
- *   qsort(values, numValues, sizeof(float), compareVectors);
- *   // 'values' will be sorted in ascending order.
- * @endcode
+ * @param writer   A pointer to an initialised writer.
+ * @param value    The value to write.
+ * @param width    The minimum field width; shorter text is padded with spaces on the left.
+ * @param decimals The number of digits after the point, clamped to [0, 6].
  */
-int compareVectors(const void *a, const void *b)
+void writerPutFloat(dmlWriter_t *writer, float value, int width, int decimals)
 {
-    return (*(float *)a > *(float *)b) - (*(float *)a < *(float *)b);
+    char text[DML_FLOAT_TEXT_MAX];
+    int len = formatFloat(text, value, decimals);
+
+    for(; width>len; width--)
+        writerPut(writer, " ", 1);
+
+    writerPut(writer, text, len);
 }
 
 /**
- * @brief Calculate the median of a specific column in a '.csv' file.
- *
- * This function calculates the median of the values in the specified column
- * of the provided '.csv' file data structure 'df->dataFrame'.
- *
- * @param df  A pointer to the '.csv' file data structure.
- * @param col The column index for which to calculate the median.
- *
- * @return The median value of the specified column.
+ * @brief Write a range of rows of a '.csv' file, optionally restricted to some columns.
  *
- * @note The '.csv' file should contain numerical data accessible via 'dataFrame'.
- *       The function creates a sorted copy of the column's values, calculates the
- *       median, and returns it.
+ * @param writer   A pointer to an initialised writer.
+ * @param df       A pointer to the '.csv' file data structure.
+ * @param firstRow The first row to write; the range is clipped to the frame.
+ * @param numRows  The number of rows to write.
+ * @param cols     A pointer to 'ncols' column indices to write, or NULL for all columns.
+ * @param ncols    The number of entries in 'cols'; ignored when 'cols' is NULL.
+ * @param decimals The number of digits after the point.
  *
- * @code
- *   // Example usage:
- *   csvData_t data = loadCsv(FILE); // Assuming the file has been loaded successfully.
- *   int targetColumn = 2; // The column for which to calculate the median.
- *   float columnMedian = median(&data, targetColumn);
- *   // Use the 'columnMedian'...
- * @endcode
+ * @note The text is only buffered; call 'writerFlush' once the output is complete.
  */
-float median(csvData_t *df, int col)
+void writeRows(dmlWriter_t *writer, csvData_t *df, int firstRow, int numRows, const int *cols, int ncols, int decimals)
 {
-    float medianVal = 0;
-    float *sortedFeature = createFloatVector(df->rows);
+    const dmlColumnar_t *view = findColumnar(df);
+    int lastRow = firstRow + numRows;
 
-    for(int index=0; index<df->rows; index++)
-        *(sortedFeature + index) = df->dataFrame[index][col];
+    if(firstRow < 0)
+        firstRow = 0;
+    if(lastRow > df->rows)
+        lastRow = df->rows;
+    if(cols == NULL)
+        ncols = df->cols;
 
-    qsort(sortedFeature, df->rows, sizeof(float), compareVectors);
+    for(int row=firstRow; row<lastRow; row++)
+    {
+        for(int index=0; index<ncols; index++)
+        {
+            int col = (cols != NULL) ? cols[index] : index;
 
-    medianVal = (df->rows % 2 == 1) ?
-                (df->dataFrame[(df->rows-1)/2][col])
-                                    :
-                ((df->dataFrame[df->rows/2][col] + df->dataFrame[df->rows/2 - 1][col]) / 2);
+            writerPutFloat(writer, frameValue(df, view, row, col), 10, decimals);
+            writerPut(writer, "\t", 1);
+        }
+        writerPut(writer, " \n", 2);
+    }
+}
 
-    free(sortedFeature);
+/**
+ * @brief Buffered counterpart of 'head': write the top rows through a 'dmlWriter_t'.
+ *
+ * @param writer   A pointer to an initialised writer.
+ * @param df       A pointer to the '.csv' file data structure.
+ * @param lines    The number of rows to write, clamped to 'df->rows'.
+ * @param cols     A pointer to 'ncols' column indices to write, or NULL for all columns.
+ * @param ncols    The number of entries in 'cols'; ignored when 'cols' is NULL.
+ * @param decimals The number of digits after the point.
+ */
+void headTo(dmlWriter_t *writer, csvData_t *df, int lines, const int *cols, int ncols, int decimals)
+{
+    static const char banner[] = "*** ================ TOP ROWS ================ ***\n";
+    static const char footer[] = "*** ========================================== ***\n";
 
-    return medianVal;
+    writerPut(writer, banner, (int)sizeof(banner) - 1);
+    writeRows(writer, df, 0, lines, cols, ncols, decimals);
+    writerPut(writer, footer, (int)sizeof(footer) - 1);
 }
 
 /**
- * @brief Calculate the standard deviation of a specific column in a '.csv' file.
+ * @brief Buffered counterpart of 'tail': write the bottom rows through a 'dmlWriter_t'.
  *
- * This function calculates the standard deviation of the values in the specified
- * column of the provided '.csv' file data structure 'df'.
+ * Rows are written from the last one upwards, like 'tail' does.
  *
- * @param df  A pointer to the '.csv' file data structure.
- * @param col The column index for which to calculate the standard deviation.
+ * @param writer   A pointer to an initialised writer.
+ * @param df       A pointer to the '.csv' file data structure.
+ * @param lines    The number of rows to write, clamped to 'df->rows'.
+ * @param cols     A pointer to 'ncols' column indices to write, or NULL for all columns.
+ * @param ncols    The number of entries in 'cols'; ignored when 'cols' is NULL.
+ * @param decimals The number of digits after the point.
+ */
+void tailTo(dmlWriter_t *writer, csvData_t *df, int lines, const int *cols, int ncols, int decimals)
+{
+    static const char banner[] = "*** ================ BOTTOM ROWS ================ ***\n";
+    static const char footer[] = "*** ============================================= ***\n";
+
+    if(lines > df->rows)
+        lines = df->rows;
+
+    writerPut(writer, banner, (int)sizeof(banner) - 1);
+    for(int row=df->rows-1; row>=df->rows-lines; row--)
+        writeRows(writer, df, row, 1, cols, ncols, decimals);
+    writerPut(writer, footer, (int)sizeof(footer) - 1);
+}
+
+/* Generator behind 'randomDataStream', seeded from the clock on first use. */
+static dmlRng_t defaultRng;
+static int defaultRngSeeded = 0;
+
+static uint32_t rotateLeft(uint32_t value, int shift)
+{
+    return (value << shift) | (value >> (32 - shift));
+}
+
+/**
+ * @brief Seed a random number generator.
  *
- * @return The standard deviation of the specified column.
+ * The 32-bit seed is expanded into the 128-bit xoshiro128** state with SplitMix32, so
+ * nearby seeds still give unrelated streams and the same seed always gives the same one.
+ *
+ * @param rng  A pointer to the generator state to initialise.
+ * @param seed Any 32-bit value.
+ */
+void rngSeed(dmlRng_t *rng, uint32_t seed)
+{
+    for(int word=0; word<4; word++)
+    {
+        uint32_t mixed = (seed += 0x9E3779B9u);
+
+        mixed = (mixed ^ (mixed >> 16)) * 0x85EBCA6Bu;
+        mixed = (mixed ^ (mixed >> 13)) * 0xC2B2AE35u;
+        rng->state[word] = mixed ^ (mixed >> 16);
+    }
+}
+
+/**
+ * @brief Draw the next uniformly distributed 32-bit value (xoshiro128**).
+ *
+ * @param rng A pointer to a seeded generator state.
+ *
+ * @return A pseudo-random value in [0, 2^32).
+ *
+ * @note Every generator owns its whole state, so threads using separate 'dmlRng_t'
+ *       objects need no locking.
+ */
+uint32_t rngNext(dmlRng_t *rng)
+{
+    uint32_t *s = rng->state;
+    uint32_t result = rotateLeft(s[1] * 5, 7) * 9;
+    uint32_t shifted = s[1] << 9;
+
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+    s[2] ^= shifted;
+    s[3] = rotateLeft(s[3], 11);
+
+    return result;
+}
+
+/**
+ * @brief Draw an unbiased pseudo-random integer in [0, bound).
+ *
+ * This function uses Lemire's multiply-and-reject method, which avoids both the modulo
+ * bias of 'rand() % bound' and, almost always, any division.
+ *
+ * @param rng   A pointer to a seeded generator state.
+ * @param bound The exclusive upper bound; must be greater than 0.
+ *
+ * @return A pseudo-random value in [0, bound).
+ */
+uint32_t rngBounded(dmlRng_t *rng, uint32_t bound)
+{
+    uint64_t product = (uint64_t)rngNext(rng) * bound;
+    uint32_t low = (uint32_t)product;
+
+    if(low < bound)
+    {
+        uint32_t threshold = (0u - bound) % bound;
+
+        while(low < threshold)
+        {
+            product = (uint64_t)rngNext(rng) * bound;
+            low = (uint32_t)product;
+        }
+    }
+
+    return (uint32_t)(product >> 32);
+}
+
+/**
+ * @brief Draw a pseudo-random float uniformly distributed in [0, 1).
+ *
+ * @param rng A pointer to a seeded generator state.
+ *
+ * @return A pseudo-random value in [0, 1) with 24 bits of resolution.
+ */
+float rngUniform(dmlRng_t *rng)
+{
+    return (float)(rngNext(rng) >> 8) * (1.0f / 16777216.0f);
+}
+
+/**
+ * @brief Generate a random data stream from a '.csv' file.
+ *
+ * This function generates a random data stream by sampling 'numOfData' values
+ * from the provided '.csv' file. The sampled values are stored in a dynamically
+ * allocated float array.
+ *
+ * @param df        A pointer to the '.csv' file data structure.
+ * @param numOfData The number of data points to sample.
+ *
+ * @return A pointer to a dynamically allocated float array containing the
+ *         sampled data points. The caller is responsible for freeing the memory
+ *         allocated for the array when it is no longer needed. NULL for an empty frame.
  *
  * @note The '.csv' file should contain numerical data accessible via 'dataFrame'.
- *       The function first calculates the mean of the column, then computes the
- *       variance by summing the squared differences between each value and the mean,
- *       and finally returns the square root of the variance as the standard deviation.
+ *       The function draws from a library-wide generator that is seeded from the
+ *       clock on the first call, so consecutive calls give different streams. It is
+ *       not thread-safe; use 'randomDataStreamRng' for reproducible or concurrent sampling.
+ *
+ * @warning The caller is responsible for freeing the memory allocated for the
+ *          returned array using the 'freeVector' function to prevent memory leaks.
  *
  * @code
  *   // Example usage:
  *   csvData_t data = loadCsv(FILE); // Assuming the file has been loaded successfully.
- *   int targetColumn = 2; // The column for which to calculate the standard deviation.
- *   float columnStdDev = standardDeviation(&data, targetColumn);
- *   // Use the 'columnStdDev'...
+ *   int numOfDataPoints = 10;
+ *   float *dataStream = randomDataStream(&data, numOfDataPoints);
+ *   // Use the dataStream...
+ *   freeVector(dataStream); // Free the allocated memory when done.
  * @endcode
  */
-float standardDeviation(csvData_t *df, int col)
+float *randomDataStream(csvData_t *df, int numOfData)
 {
-    float sum = 0;
-    float meanVal = mean(df, col);
+    if(!defaultRngSeeded)
+    {
+        rngSeed(&defaultRng, (uint32_t)time(NULL));
+        defaultRngSeeded = 1;
+    }
 
-    for(int row=0; row<df->rows; row++)
+    return randomDataStreamRng(df, numOfData, &defaultRng);
+}
+
+/**
+ * @brief Generate a random data stream from a '.csv' file with an explicit generator.
+ *
+ * This function behaves like 'randomDataStream' but draws the (row, column) indices
+ * from 'rng', so the same seed reproduces the same stream and threads with their own
+ * generators can sample concurrently.
+ *
+ * @param df        A pointer to the '.csv' file data structure.
+ * @param numOfData The number of data points to sample.
+ * @param rng       A pointer to a seeded generator state.
+ *
+ * @return A pointer to a dynamically allocated float array containing the sampled
+ *         data points, to be released with 'freeVector'. NULL if 'df' has no rows or
+ *         columns, or if the memory could not be allocated.
+ *
+ * @code
+ *   // Example usage:
+ *   dmlRng_t rng;
+ *   rngSeed(&rng, 42);
+ *   float *dataStream = randomDataStreamRng(&data, 10, &rng);
+ *   freeVector(dataStream);
+ * @endcode
+ */
+float *randomDataStreamRng(csvData_t *df, int numOfData, dmlRng_t *rng)
+{
+    DML_PROFILE_BEGIN(DML_PROF_RANDOM_DATA_STREAM, numOfData);
+
+    float *stream;
+    const dmlColumnar_t *view = findColumnar(df);
+
+    if(df->rows <= 0 || df->cols <= 0)
+    {
+        DML_PROFILE_END();
+        return NULL;
+    }
+
+    stream = (float *)dmlAlloc(sizeof(float) * numOfData);
+
+    if(stream == NULL)
+    {
+        DML_PROFILE_END();
+        return NULL;
+    }
+
+    for(int num=0; num<numOfData; num++)
     {
-        float distance = df->dataFrame[row][col] - meanVal;
-        sum += distance * distance;
+        int xIndex = (int)rngBounded(rng, (uint32_t)df->rows);
+        int yIndex = (int)rngBounded(rng, (uint32_t)df->cols);
+
+        *(stream + num) = (view != NULL) ? view->data[(long)yIndex * view->stride + xIndex]
+                                         : df->dataFrame[xIndex][yIndex];
     }
 
-    return (sum / (float)df->rows);
+    DML_PROFILE_END();
+    return stream;
 }
 
 /**
- * @brief Scale a float vector to the range [0, 1] (unity) given custom bounds.
+ * @brief Move a uniformly random selection of 'count' entries of 'indices' to its front.
  *
- * This function scales each element of the input float vector 'vector' to the
- * range [0, 1] (unity) based on the specified 'lowerBound' and 'upperBound'.
- * The scaled values are stored in a dynamically allocated float array.
+ * This function runs the first 'count' steps of a Fisher-Yates shuffle, so it costs
+ * O(count) regardless of 'len'. Calling it with 'count == len' shuffles the whole array,
+ * e.g. to reorder rows between training epochs without reallocating.
  *
- * @param vector      A pointer to the input float vector to be scaled.
- * @param vectorLen   The length of the input vector.
- * @param lowerBound  The lower bound of the desired range.
- * @param upperBound  The upper bound of the desired range.
+ * @param indices A pointer to 'len' integers to permute in place.
+ * @param len     The number of entries in 'indices'.
+ * @param count   The number of entries to draw, at most 'len'.
+ * @param rng     A pointer to a seeded generator state.
+ */
+void partialShuffle(int *indices, int len, int count, dmlRng_t *rng)
+{
+    for(int draw=0; draw<count && draw<len-1; draw++)
+    {
+        int pick = draw + (int)rngBounded(rng, (uint32_t)(len - draw));
+        int temp = indices[draw];
+
+        indices[draw] = indices[pick];
+        indices[pick] = temp;
+    }
+}
+
+/**
+ * @brief Sample distinct rows of a '.csv' file without replacement.
  *
- * @return A pointer to a dynamically allocated float array containing the scaled values.
- *         The caller is responsible for freeing the memory allocated for the array
- *         when it is no longer needed.
+ * This function draws 'sampleSize' different row indices uniformly at random with a
+ * partial Fisher-Yates shuffle. Only indices are returned, so the selected rows can be
+ * read in place through 'df->dataFrame[indices[i]]' without copying them.
  *
- * @warning The caller must free the memory allocated for the returned array using
- *          the 'free' function to prevent memory leaks when it is no longer needed.
+ * @param df         A pointer to the '.csv' file data structure.
+ * @param sampleSize The number of rows to draw; values above 'df->rows' are clamped.
+ * @param rng        A pointer to a seeded generator state.
  *
- * @note The function scales each element of 'vector' individually based on the provided
- *       'lowerBound' and 'upperBound' values.
+ * @return A pointer to a dynamically allocated array whose first 'sampleSize' entries are
+ *         the drawn row indices, or NULL if the allocation failed. The caller must release
+ *         it with 'freeVector'.
  *
  * @code
  *   // Example usage:
- *   int vectorLength = 5;
- *   float originalVector[] = {1.0, 2.0, 3.0, 4.0, 5.0};
- *   float lowerBound = 1.0;
- *   float upperBound = 5.0;
- *   float *scaledVector = scaleToUnity(originalVector, vectorLength, lowerBound, upperBound);
- *   // Use the 'scaledVector'...
- *   free(scaledVector); // Free the allocated memory when done.
+ *   dmlRng_t rng;
+ *   rngSeed(&rng, 7);
+ *   int *rows = sampleRows(&data, 32, &rng);
+ *   float firstFeature = data.dataFrame[rows[0]][0];
+ *   freeVector(rows);
  * @endcode
  */
-float *scaleToUnity(float *vector, int vectorLen, float lowerBound, float upperBound)
+int *sampleRows(csvData_t *df, int sampleSize, dmlRng_t *rng)
 {
-    float *unity = (float *)malloc(sizeof(float) * vectorLen);
+    DML_PROFILE_BEGIN(DML_PROF_SAMPLE_ROWS, df->rows);
 
-    for(int loop=0; loop<vectorLen; loop++)
+    int *indices = (int *)dmlAlloc(sizeof(int) * (df->rows > 0 ? df->rows : 1));
+
+    if(indices == NULL)
     {
-        *(unity + loop) = *(vector + loop) / (upperBound - lowerBound);
+        DML_PROFILE_END();
+        return NULL;
     }
 
-    return unity;
+    if(sampleSize > df->rows)
+        sampleSize = df->rows;
+
+    for(int row=0; row<df->rows; row++)
+        indices[row] = row;
+
+    partialShuffle(indices, df->rows, sampleSize, rng);
+
+    DML_PROFILE_END();
+    return indices;
 }
 
 /**
- * @brief Scale a float vector from one range to another given custom bounds.
+ * @brief Prepare a reservoir sampler that keeps up to 'capacity' row indices.
  *
- * This function scales each element of the input float vector 'vector' from the
- * range defined by 'lowerBound' and 'upperBound' to a new range defined by
- * 'newLowBound' and 'newUpBound'. The scaled values are stored in a dynamically
- * allocated float array.
+ * @param reservoir A pointer to the sampler to initialise.
+ * @param buffer    A pointer to 'capacity' integers owned by the caller, receiving the indices.
+ * @param capacity  The number of rows to keep.
+ */
+void reservoirInit(dmlReservoir_t *reservoir, int *buffer, int capacity)
+{
+    reservoir->indices = buffer;
+    reservoir->capacity = capacity;
+    reservoir->filled = 0;
+    reservoir->seen = 0;
+}
+
+/**
+ * @brief Offer the next row of a stream to a reservoir sampler (Algorithm R).
  *
- * @param vector      A pointer to the input float vector to be scaled.
- * @param vectorLen   The length of the input vector.
- * @param lowerBound  The lower bound of the original range.
- * @param upperBound  The upper bound of the original range.
- * @param newLowBound The lower bound of the new range.
- * @param newUpBound  The upper bound of the new range.
+ * Rows are numbered in the order they are offered. After any number of calls the
+ * reservoir holds a uniform random sample of the rows seen so far, without the total
+ * number of rows ever being known, so it can run while a '.csv' file is being read.
  *
- * @return A pointer to a dynamically allocated float array containing the scaled values.
- *         The caller is responsible for freeing the memory allocated for the array
- *         when it is no longer needed.
+ * @param reservoir A pointer to an initialised sampler.
+ * @param rng       A pointer to a seeded generator state.
  *
- * @warning The caller must free the memory allocated for the returned array using
- *          the 'free' function to prevent memory leaks when it is no longer needed.
+ * @return The reservoir slot the row was stored in, or -1 if the row was not selected.
+ *         When a slot is returned, a caller keeping copies of the sampled rows should
+ *         overwrite its copy in that slot with the current row.
  *
- * @note The function scales each element of 'vector' individually based on the provided
- *       bounds and computes the scaled values according to the new range.
+ * @code
+ *   // Example usage:
+ *   int kept[16];
+ *   float rowsKept[16][FEATURES];
+ *   dmlReservoir_t reservoir;
+ *   reservoirInit(&reservoir, kept, 16);
+ *   while(readRow(row))
+ *   {
+ *       int slot = reservoirOffer(&reservoir, &rng);
+ *       if(slot >= 0)
+ *           memcpy(rowsKept[slot], row, sizeof(rowsKept[slot]));
+ *   }
+ * @endcode
+ */
+int reservoirOffer(dmlReservoir_t *reservoir, dmlRng_t *rng)
+{
+    long row = reservoir->seen++;
+    int slot = -1;
+
+    if(reservoir->filled < reservoir->capacity)
+    {
+        slot = reservoir->filled++;
+    }
+    else if(reservoir->capacity > 0)
+    {
+        uint32_t pick = rngBounded(rng, (uint32_t)reservoir->seen);
+
+        if(pick < (uint32_t)reservoir->capacity)
+            slot = (int)pick;
+    }
+
+    if(slot >= 0)
+        reservoir->indices[slot] = (int)row;
+
+    return slot;
+}
+
+typedef struct labelledRow
+{
+    float label;
+    int row;
+} labelledRow_t;
+
+static int compareLabelledRows(const void *a, const void *b)
+{
+    const labelledRow_t *left = (const labelledRow_t *)a;
+    const labelledRow_t *right = (const labelledRow_t *)b;
+    int byLabel = compareVectors(&left->label, &right->label);
+
+    return (byLabel != 0) ? byLabel : (left->row > right->row) - (left->row < right->row);
+}
+
+/**
+ * @brief Sample rows of a '.csv' file stratified by the value of a label column.
+ *
+ * This function groups the rows by the value in 'labelCol' and draws, without
+ * replacement, round('fraction' * group size) rows from every group, so the class
+ * proportions of the sample match those of the whole frame.
+ *
+ * @param df         A pointer to the '.csv' file data structure.
+ * @param labelCol   The column holding the class labels.
+ * @param fraction   The share of every group to keep, in [0, 1].
+ * @param sampleSize A pointer receiving the number of indices returned.
+ * @param rng        A pointer to a seeded generator state.
+ *
+ * @return A pointer to a dynamically allocated array of '*sampleSize' row indices,
+ *         grouped by label, or NULL if the allocation failed. The caller must release
+ *         it with 'freeVector'.
  *
  * @code
  *   // Example usage:
- *   int vectorLength = 5;
- *   float originalVector[] = {1.0, 2.0, 3.0, 4.0, 5.0};
- *   float lowerBound = 1.0;
- *   float upperBound = 5.0;
- *   float newLowerBound = 0.0;
- *   float newUpperBound = 1.0;
- *   float *scaledVector = scaleVector(originalVector, vectorLength, lowerBound, upperBound, newLowerBound, newUpperBound);
- *   // Use the 'scaledVector'...
- *   free(scaledVector); // Free the allocated memory when done.
+ *   int count;
+ *   int *rows = stratifiedSample(&data, data.cols - 1, 0.2, &count, &rng);
+ *   // ... use data.dataFrame[rows[i]] for i < count ...
+ *   freeVector(rows);
  * @endcode
  */
-float *scaleVector(float *vector, int vectorLen, float lowerBound, float upperBound, float newLowBound, float newUpBound)
+int *stratifiedSample(csvData_t *df, int labelCol, float fraction, int *sampleSize, dmlRng_t *rng)
 {
-    float *scaledDownVector = (float *)malloc(sizeof(float) * vectorLen);
+    int *indices = (int *)dmlAlloc(sizeof(int) * (df->rows > 0 ? df->rows : 1));
+    labelledRow_t *rows = (labelledRow_t *)dmlAlloc(sizeof(labelledRow_t) * (df->rows > 0 ? df->rows : 1));
+    const dmlColumnar_t *view = findColumnar(df);
+    int taken = 0;
 
-    float scale = (newUpBound - newLowBound) / (upperBound - lowerBound);
-    float offset = newLowBound - (scale * lowerBound);
+    *sampleSize = 0;
 
-    for(int loop=0; loop<vectorLen; loop++)
+    if(rows == NULL || indices == NULL)
     {
-        *(scaledDownVector + loop) = *(vector + loop) * scale + offset;
+        dmlFree(rows);
+        dmlFree(indices);
+        return NULL;
     }
 
-    return scaledDownVector;
+    for(int row=0; row<df->rows; row++)
+    {
+        rows[row].label = frameValue(df, view, row, labelCol);
+        rows[row].row = row;
+    }
+
+    qsort(rows, df->rows, sizeof(labelledRow_t), compareLabelledRows);
+
+    for(int start=0; start<df->rows; )
+    {
+        int end = start + 1;
+
+        while(end < df->rows && rows[end].label == rows[start].label)
+            end++;
+
+        int groupLen = end - start;
+        int groupTake = (int)(fraction * (float)groupLen + 0.5f);
+
+        if(groupTake > groupLen)
+            groupTake = groupLen;
+
+        for(int member=0; member<groupLen; member++)
+            indices[taken + member] = rows[start + member].row;
+
+        partialShuffle(indices + taken, groupLen, groupTake, rng);
+        taken += groupTake;
+        start = end;
+    }
+
+    dmlFree(rows);
+    *sampleSize = taken;
+
+    return indices;
+}
+
+/**
+ * @brief Prepare a mini-batch iterator over the rows of a '.csv' file.
+ *
+ * This function allocates the row order once; afterwards 'batchIterNext' copies batches
+ * into the caller's buffer and 'batchIterReset' reshuffles for a new epoch, neither of
+ * which allocates.
+ *
+ * @param iter      A pointer to the iterator to initialise.
+ * @param df        A pointer to the '.csv' file data structure.
+ * @param batchSize The maximum number of rows per batch.
+ * @param buffer    A pointer to 'batchSize * df->cols' floats owned by the caller, which
+ *                  every batch is written to in row-major order.
+ * @param shuffle   Non-zero to visit the rows in a new random order every epoch.
+ * @param rng       A pointer to a seeded generator state; only used when 'shuffle' is set.
+ *
+ * @return 0 on success, -1 if the row order could not be allocated.
+ *
+ * @warning The caller must release the iterator with 'batchIterFree'.
+ *
+ * @code
+ *   // Example usage:
+ *   float block[32 * FEATURES];
+ *   dmlBatchIter_t iter;
+ *   dmlBatch_t batch;
+ *   batchIterInit(&iter, &data, 32, block, 1, &rng);
+ *   for(int epoch=0; epoch<10; epoch++)
+ *   {
+ *       while(batchIterNext(&iter, &batch) > 0)
+ *           trainStep(batch.data, batch.rows, batch.cols);
+ *       batchIterReset(&iter);
+ *   }
+ *   batchIterFree(&iter);
+ * @endcode
+ */
+int batchIterInit(dmlBatchIter_t *iter, csvData_t *df, int batchSize, float *buffer, int shuffle, dmlRng_t *rng)
+{
+    iter->df = df;
+    iter->batchSize = batchSize;
+    iter->buffer = buffer;
+    iter->shuffle = shuffle;
+    iter->rng = rng;
+    iter->position = 0;
+    iter->epoch = 0;
+    iter->order = (int *)dmlAlloc(sizeof(int) * (df->rows > 0 ? df->rows : 1));
+
+    if(iter->order == NULL)
+        return -1;
+
+    for(int row=0; row<df->rows; row++)
+        iter->order[row] = row;
+
+    if(shuffle)
+        partialShuffle(iter->order, df->rows, df->rows, rng);
+
+    return 0;
+}
+
+/**
+ * @brief Copy the next mini-batch of the current epoch into the iterator's buffer.
+ *
+ * @param iter  A pointer to an initialised iterator.
+ * @param batch A pointer receiving the description of the batch: 'data' points to the
+ *              caller's buffer holding 'rows' x 'cols' floats row by row, and 'indices'
+ *              lists the frame rows they came from (e.g. to look up labels).
+ *
+ * @return The number of rows in the batch; 0 once the epoch is exhausted.
+ */
+int batchIterNext(dmlBatchIter_t *iter, dmlBatch_t *batch)
+{
+    csvData_t *df = iter->df;
+    const dmlColumnar_t *view = findColumnar(df);
+    int remaining = df->rows - iter->position;
+    int rows = (remaining < iter->batchSize) ? remaining : iter->batchSize;
+
+    batch->data = iter->buffer;
+    batch->rows = rows;
+    batch->cols = df->cols;
+    batch->indices = iter->order + iter->position;
+
+    for(int row=0; row<rows; row++)
+    {
+        float *target = iter->buffer + (long)row * df->cols;
+
+        if(view == NULL)
+        {
+            memcpy(target, df->dataFrame[batch->indices[row]], sizeof(float) * df->cols);
+            continue;
+        }
+
+        for(int col=0; col<df->cols; col++)
+            target[col] = frameValue(df, view, batch->indices[row], col);
+    }
+
+    iter->position += rows;
+
+    return rows;
+}
+
+/**
+ * @brief Start a new epoch, reshuffling the row order in O(rows) if shuffling is enabled.
+ *
+ * @param iter A pointer to an initialised iterator.
+ */
+void batchIterReset(dmlBatchIter_t *iter)
+{
+    iter->position = 0;
+    iter->epoch++;
+
+    if(iter->shuffle)
+        partialShuffle(iter->order, iter->df->rows, iter->df->rows, iter->rng);
+}
+
+/**
+ * @brief Release the row order held by a mini-batch iterator.
+ *
+ * @param iter A pointer to an initialised iterator. The caller's buffer is not freed.
+ */
+void batchIterFree(dmlBatchIter_t *iter)
+{
+    dmlFree(iter->order);
+    iter->order = NULL;
+}
+
+/**
+ * @brief Install the allocator used by every allocating function of the library.
+ *
+ * @param allocator A pointer to the allocator to use; it is copied. NULL restores the
+ *                  default, which is 'malloc'/'free', or a static DML_STATIC_HEAP_SIZE
+ *                  byte arena in DML_NO_HEAP builds (see dml.h for how to size it).
+ *
+ * @note Memory must be released through the allocator that provided it, so switch
+ *       allocators only when no library-allocated memory is outstanding. Installing an
+ *       allocator is not thread-safe.
+ *
+ * @code
+ *   // Example usage:
+ *   dmlAllocator_t pool = {poolAlloc, poolRelease, &myPool};
+ *   setAllocator(&pool);
+ * @endcode
+ */
+void setAllocator(const dmlAllocator_t *allocator)
+{
+    if(allocator != NULL)
+    {
+        currentAllocator = *allocator;
+    }
+    else
+    {
+        currentAllocator.alloc = NULL;
+        currentAllocator.release = NULL;
+        currentAllocator.context = NULL;
+    }
+}
+
+/**
+ * @brief Release memory returned by any allocating function of the library.
+ *
+ * With the default heap allocator this is equivalent to 'free'; with any other allocator
+ * (including DML_NO_HEAP builds) it must be used instead.
+ *
+ * @param block A pointer returned by the library, or NULL.
+ */
+void freeVector(void *block)
+{
+    dmlFree(block);
+}
+
+/**
+ * @brief Prepare a bump arena over a caller-provided buffer.
+ *
+ * @param arena    A pointer to the arena to initialise.
+ * @param buffer   A pointer to the memory to hand out, e.g. a static array. It need not
+ *                 be aligned: the arena starts at its first DML_ARENA_ALIGN boundary.
+ * @param capacity The size of 'buffer' in bytes.
+ */
+void arenaInit(dmlArena_t *arena, void *buffer, size_t capacity)
+{
+    size_t skip = (size_t)((DML_ARENA_ALIGN - (uintptr_t)buffer % DML_ARENA_ALIGN) % DML_ARENA_ALIGN);
+
+    if(skip > capacity)
+        skip = capacity;
+
+    arena->base = (unsigned char *)buffer + skip;
+    arena->capacity = capacity - skip;
+    arena->used = 0;
+}
+
+/*
+ * Every arena block is preceded by the arena offset it started at and the offset it ends
+ * at, so freeing the most recent block gives its memory back immediately.
+ */
+typedef struct arenaHeader
+{
+    size_t start;
+    size_t end;
+} arenaHeader_t;
+
+/**
+ * @brief Allocate 'size' bytes from an arena in O(1).
+ *
+ * @param arena A pointer to an initialised arena.
+ * @param size  The number of bytes to allocate.
+ *
+ * @return A pointer aligned to DML_ARENA_ALIGN bytes, or NULL if the arena is exhausted.
+ */
+void *arenaAlloc(dmlArena_t *arena, size_t size)
+{
+    size_t start = arena->used;
+    size_t offset = (start + sizeof(arenaHeader_t) + DML_ARENA_ALIGN - 1) / DML_ARENA_ALIGN * DML_ARENA_ALIGN;
+    arenaHeader_t header;
+
+    if(offset > arena->capacity || size > arena->capacity - offset)
+        return NULL;
+
+    header.start = start;
+    header.end = offset + size;
+    memcpy(arena->base + offset - sizeof(arenaHeader_t), &header, sizeof(header));
+    arena->used = header.end;
+
+    return arena->base + offset;
+}
+
+/**
+ * @brief Return a block to an arena.
+ *
+ * The memory is reclaimed at once when 'block' is the most recent live allocation, which
+ * covers the temporary buffers of 'median', 'describe' and friends; otherwise it is
+ * reclaimed by the next 'arenaReset' below it.
+ *
+ * @param arena A pointer to the arena 'block' came from.
+ * @param block A pointer returned by 'arenaAlloc', or NULL.
+ */
+void arenaFree(dmlArena_t *arena, void *block)
+{
+    arenaHeader_t header;
+
+    if(block == NULL)
+        return;
+
+    memcpy(&header, (unsigned char *)block - sizeof(arenaHeader_t), sizeof(header));
+
+    if(header.end == arena->used)
+        arena->used = header.start;
+}
+
+/**
+ * @brief Remember the current fill level of an arena, for a later 'arenaReset'.
+ *
+ * @param arena A pointer to an initialised arena.
+ *
+ * @return An opaque mark.
+ */
+size_t arenaMark(const dmlArena_t *arena)
+{
+    return arena->used;
+}
+
+/**
+ * @brief Release everything allocated from an arena since 'mark' was taken, in O(1).
+ *
+ * @param arena A pointer to an initialised arena.
+ * @param mark  A value returned by 'arenaMark'; 0 empties the arena.
+ *
+ * @code
+ *   // Example usage: deterministic, heap-free processing of one frame.
+ *   static unsigned char scratch[1024];
+ *   dmlArena_t arena;
+ *   arenaInit(&arena, scratch, sizeof(scratch));
+ *   useArena(&arena);
+ *   size_t mark = arenaMark(&arena);
+ *   float *scaled = scaleVector(vector, len, lo, hi, 0.0, 1.0);
+ *   // ...
+ *   arenaReset(&arena, mark); // 'scaled' and everything after it are gone.
+ * @endcode
+ */
+void arenaReset(dmlArena_t *arena, size_t mark)
+{
+    if(mark <= arena->used)
+        arena->used = mark;
+}
+
+/**
+ * @brief Make the library allocate from 'arena'.
+ *
+ * @param arena A pointer to an initialised arena; it must outlive its use by the library.
+ */
+void useArena(dmlArena_t *arena)
+{
+    dmlAllocator_t allocator = {arenaAllocAdapter, arenaReleaseAdapter, arena};
+
+    setAllocator(&allocator);
+}
+
+#if defined(DML_NO_HEAP)
+/**
+ * @brief Get the static arena backing the default allocator of DML_NO_HEAP builds.
+ *
+ * @return A pointer to the arena, e.g. to take an 'arenaMark' and later 'arenaReset' it.
+ */
+dmlArena_t *staticArena(void)
+{
+    return &staticHeapArena;
+}
+#endif
+
+/**
+ * @brief Create a dynamically allocated float vector.
+ *
+ * This function allocates memory for a float vector of the specified length 'len'
+ * and returns a pointer to the allocated memory. The caller is responsible for
+ * freeing the memory when it is no longer needed.
+ *
+ * @param len The length of the float vector to create.
+ *
+ * @return A pointer to the dynamically allocated float vector.
+ *
+ * @note The memory comes from the allocator installed with 'setAllocator' ('malloc' by
+ *       default), like every other allocation made by the library.
+ *
+ * @warning The caller must free the memory allocated for the vector using the 'freeVector'
+ *          function to prevent memory leaks when it is no longer needed.
+ *
+ * @code
+ *   // Example usage:
+ *   int vectorLength = 10;
+ *   float *dataVector = createFloatVector(vectorLength);
+ *   // Use the 'dataVector'...
+ *   freeVector(dataVector); // Free the allocated memory when done.
+ * @endcode
+ */
+float *createFloatVector(int len)
+{
+    float *vector = (float *)dmlAlloc(sizeof(float) * len);
+
+    return vector;
+}
+
+#if defined(DML_SIMD_SSE)
+static float sseHorizontalSum(__m128 v)
+{
+    __m128 shuffled = _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 3, 0, 1));
+    __m128 sums = _mm_add_ps(v, shuffled);
+
+    shuffled = _mm_movehl_ps(shuffled, sums);
+    sums = _mm_add_ss(sums, shuffled);
+
+    return _mm_cvtss_f32(sums);
+}
+
+static float sseHorizontalMin(__m128 v)
+{
+    __m128 shuffled = _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 3, 0, 1));
+    __m128 mins = _mm_min_ps(v, shuffled);
+
+    shuffled = _mm_movehl_ps(shuffled, mins);
+    mins = _mm_min_ss(mins, shuffled);
+
+    return _mm_cvtss_f32(mins);
+}
+
+static float sseHorizontalMax(__m128 v)
+{
+    __m128 shuffled = _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 3, 0, 1));
+    __m128 maxs = _mm_max_ps(v, shuffled);
+
+    shuffled = _mm_movehl_ps(shuffled, maxs);
+    maxs = _mm_max_ss(maxs, shuffled);
+
+    return _mm_cvtss_f32(maxs);
+}
+#endif
+
+#if defined(DML_SIMD_NEON)
+static float neonHorizontalSum(float32x4_t v)
+{
+#if defined(__aarch64__)
+    return vaddvq_f32(v);
+#else
+    float32x2_t pair = vadd_f32(vget_low_f32(v), vget_high_f32(v));
+    pair = vpadd_f32(pair, pair);
+    return vget_lane_f32(pair, 0);
+#endif
+}
+
+static float neonHorizontalMin(float32x4_t v)
+{
+#if defined(__aarch64__)
+    return vminvq_f32(v);
+#else
+    float32x2_t pair = vmin_f32(vget_low_f32(v), vget_high_f32(v));
+    pair = vpmin_f32(pair, pair);
+    return vget_lane_f32(pair, 0);
+#endif
+}
+
+static float neonHorizontalMax(float32x4_t v)
+{
+#if defined(__aarch64__)
+    return vmaxvq_f32(v);
+#else
+    float32x2_t pair = vmax_f32(vget_low_f32(v), vget_high_f32(v));
+    pair = vpmax_f32(pair, pair);
+    return vget_lane_f32(pair, 0);
+#endif
+}
+#endif
+
+/**
+ * @brief Name of the SIMD backend the vector kernels were compiled with.
+ *
+ * @return One of "cmsis-dsp", "avx", "sse", "neon" or "scalar".
+ */
+const char *simdBackend(void)
+{
+#if defined(DML_SIMD_CMSIS)
+    return "cmsis-dsp";
+#elif defined(DML_SIMD_AVX)
+    return "avx";
+#elif defined(DML_SIMD_SSE)
+    return "sse";
+#elif defined(DML_SIMD_NEON)
+    return "neon";
+#else
+    return "scalar";
+#endif
+}
+
+/** @brief SIMD sum of one block of 'sumVector'; the lanes accumulate in float. */
+static float sumBlock(const float *vector, int vectorLen)
+{
+    float sum = 0;
+    int index = 0;
+
+#if defined(DML_SIMD_CMSIS)
+    if(vectorLen > 0)
+    {
+        float32_t meanVal;
+
+        arm_mean_f32(vector, (uint32_t)vectorLen, &meanVal);
+        return meanVal * (float)vectorLen;
+    }
+#elif defined(DML_SIMD_AVX)
+    __m256 acc0 = _mm256_setzero_ps();
+    __m256 acc1 = _mm256_setzero_ps();
+
+    for(; index+16<=vectorLen; index+=16)
+    {
+        acc0 = _mm256_add_ps(acc0, _mm256_loadu_ps(vector + index));
+        acc1 = _mm256_add_ps(acc1, _mm256_loadu_ps(vector + index + 8));
+    }
+    acc0 = _mm256_add_ps(acc0, acc1);
+    sum = sseHorizontalSum(_mm_add_ps(_mm256_castps256_ps128(acc0), _mm256_extractf128_ps(acc0, 1)));
+#elif defined(DML_SIMD_SSE)
+    __m128 acc0 = _mm_setzero_ps();
+    __m128 acc1 = _mm_setzero_ps();
+
+    for(; index+8<=vectorLen; index+=8)
+    {
+        acc0 = _mm_add_ps(acc0, _mm_loadu_ps(vector + index));
+        acc1 = _mm_add_ps(acc1, _mm_loadu_ps(vector + index + 4));
+    }
+    sum = sseHorizontalSum(_mm_add_ps(acc0, acc1));
+#elif defined(DML_SIMD_NEON)
+    float32x4_t acc0 = vdupq_n_f32(0);
+    float32x4_t acc1 = vdupq_n_f32(0);
+
+    for(; index+8<=vectorLen; index+=8)
+    {
+        acc0 = vaddq_f32(acc0, vld1q_f32(vector + index));
+        acc1 = vaddq_f32(acc1, vld1q_f32(vector + index + 4));
+    }
+    sum = neonHorizontalSum(vaddq_f32(acc0, acc1));
+#endif
+
+    for(; index<vectorLen; index++)
+        sum += *(vector + index);
+
+    return sum;
+}
+
+/** @brief SIMD sum of squares of one block of 'sumOfSquaresVector'. */
+static float sumOfSquaresBlock(const float *vector, int vectorLen)
+{
+    float sum = 0;
+    int index = 0;
+
+#if defined(DML_SIMD_CMSIS)
+    if(vectorLen > 0)
+    {
+        float32_t power;
+
+        arm_power_f32(vector, (uint32_t)vectorLen, &power);
+        return power;
+    }
+#elif defined(DML_SIMD_AVX)
+    __m256 acc0 = _mm256_setzero_ps();
+    __m256 acc1 = _mm256_setzero_ps();
+
+    for(; index+16<=vectorLen; index+=16)
+    {
+        __m256 x0 = _mm256_loadu_ps(vector + index);
+        __m256 x1 = _mm256_loadu_ps(vector + index + 8);
+
+        acc0 = _mm256_add_ps(acc0, _mm256_mul_ps(x0, x0));
+        acc1 = _mm256_add_ps(acc1, _mm256_mul_ps(x1, x1));
+    }
+    acc0 = _mm256_add_ps(acc0, acc1);
+    sum = sseHorizontalSum(_mm_add_ps(_mm256_castps256_ps128(acc0), _mm256_extractf128_ps(acc0, 1)));
+#elif defined(DML_SIMD_SSE)
+    __m128 acc0 = _mm_setzero_ps();
+    __m128 acc1 = _mm_setzero_ps();
+
+    for(; index+8<=vectorLen; index+=8)
+    {
+        __m128 x0 = _mm_loadu_ps(vector + index);
+        __m128 x1 = _mm_loadu_ps(vector + index + 4);
+
+        acc0 = _mm_add_ps(acc0, _mm_mul_ps(x0, x0));
+        acc1 = _mm_add_ps(acc1, _mm_mul_ps(x1, x1));
+    }
+    sum = sseHorizontalSum(_mm_add_ps(acc0, acc1));
+#elif defined(DML_SIMD_NEON)
+    float32x4_t acc0 = vdupq_n_f32(0);
+    float32x4_t acc1 = vdupq_n_f32(0);
+
+    for(; index+8<=vectorLen; index+=8)
+    {
+        float32x4_t x0 = vld1q_f32(vector + index);
+        float32x4_t x1 = vld1q_f32(vector + index + 4);
+
+        acc0 = vmlaq_f32(acc0, x0, x0);
+        acc1 = vmlaq_f32(acc1, x1, x1);
+    }
+    sum = neonHorizontalSum(vaddq_f32(acc0, acc1));
+#endif
+
+    for(; index<vectorLen; index++)
+        sum += *(vector + index) * *(vector + index);
+
+    return sum;
+}
+
+/**
+ * @brief Combination of block sums according to DML_SUMMATION.
+ *
+ * The pairwise variant works like a binary counter: 'partial[level]' holds the sum of
+ * 2^level blocks, and two partials of the same level are merged as soon as both exist,
+ * so the sums form a balanced tree without knowing the number of blocks in advance.
+ */
+typedef struct sumAccumulator
+{
+    dmlAccum_t sum;
+    dmlAccum_t compensation;
+#if DML_SUMMATION == DML_SUM_PAIRWISE
+    dmlAccum_t partial[32];
+    unsigned long blocks;
+#endif
+} sumAccumulator_t;
+
+static void sumAccumulatorInit(sumAccumulator_t *acc)
+{
+    acc->sum = 0;
+    acc->compensation = 0;
+#if DML_SUMMATION == DML_SUM_PAIRWISE
+    acc->blocks = 0;
+#endif
+}
+
+static void sumAccumulatorAdd(sumAccumulator_t *acc, dmlAccum_t value)
+{
+#if DML_SUMMATION == DML_SUM_PAIRWISE
+    int level = 0;
+
+    while(acc->blocks & (1ul << level))
+    {
+        value += acc->partial[level];
+        level++;
+    }
+    acc->partial[level] = value;
+    acc->blocks++;
+#elif DML_SUMMATION == DML_SUM_KAHAN
+    dmlAccum_t corrected = value - acc->compensation;
+    dmlAccum_t total = acc->sum + corrected;
+
+    acc->compensation = (total - acc->sum) - corrected;
+    acc->sum = total;
+#else
+    acc->sum += value;
+#endif
+}
+
+static dmlAccum_t sumAccumulatorResult(const sumAccumulator_t *acc)
+{
+#if DML_SUMMATION == DML_SUM_PAIRWISE
+    dmlAccum_t total = 0;
+
+    for(int level=0; level<32; level++)
+    {
+        if(acc->blocks & (1ul << level))
+            total += acc->partial[level];
+    }
+
+    return total;
+#else
+    return acc->sum;
+#endif
+}
+
+/** @brief Sum (or sum of squares) of a contiguous vector, block by block, in 'dmlAccum_t'. */
+static dmlAccum_t accumulateVector(const float *vector, int vectorLen, int squares)
+{
+    sumAccumulator_t acc;
+
+    sumAccumulatorInit(&acc);
+
+    for(int index=0; index<vectorLen; index+=DML_SUM_BLOCK)
+    {
+        int blockLen = (vectorLen - index < DML_SUM_BLOCK) ? vectorLen - index : DML_SUM_BLOCK;
+
+        sumAccumulatorAdd(&acc, squares ? sumOfSquaresBlock(vector + index, blockLen)
+                                        : sumBlock(vector + index, blockLen));
+    }
+
+    return sumAccumulatorResult(&acc);
+}
+
+/**
+ * @brief Sum the elements of a contiguous float vector.
+ *
+ * This function uses the SIMD backend selected at compile time (see 'simdBackend') and
+ * falls back to a scalar loop for the tail and for targets without vector units.
+ *
+ * @param vector    A pointer to the input float vector.
+ * @param vectorLen The length of the input vector.
+ *
+ * @return The sum of all elements, or 0 for an empty vector.
+ *
+ * @note The vector is summed in blocks of DML_SUM_BLOCK elements whose sums are combined in
+ *       'dmlAccum_t' as selected by DML_SUMMATION, so the result may differ from a strictly
+ *       sequential sum in the last bits.
+ */
+float sumVector(const float *vector, int vectorLen)
+{
+    DML_PROFILE_BEGIN(DML_PROF_SUM_VECTOR, vectorLen);
+    float sum = (float)accumulateVector(vector, vectorLen, 0);
+
+    DML_PROFILE_END();
+    return sum;
+}
+
+/**
+ * @brief Sum the squares of the elements of a contiguous float vector.
+ *
+ * @param vector    A pointer to the input float vector.
+ * @param vectorLen The length of the input vector.
+ *
+ * @return The sum of squared elements, or 0 for an empty vector.
+ *
+ * @note Like 'sumVector', this function uses the compile-time selected SIMD backend and
+ *       summation algorithm.
+ */
+float sumOfSquaresVector(const float *vector, int vectorLen)
+{
+    DML_PROFILE_BEGIN(DML_PROF_SUM_OF_SQUARES_VECTOR, vectorLen);
+    float sum = (float)accumulateVector(vector, vectorLen, 1);
+
+    DML_PROFILE_END();
+    return sum;
+}
+
+/**
+ * @brief Find the smallest and the largest element of a contiguous float vector in one pass.
+ *
+ * @param vector    A pointer to the input float vector; it must hold at least one element.
+ * @param vectorLen The length of the input vector.
+ * @param minOut    A pointer receiving the smallest element, or NULL if not needed.
+ * @param maxOut    A pointer receiving the largest element, or NULL if not needed.
+ *
+ * @code
+ *   // Example usage:
+ *   float lowerBound, upperBound;
+ *   minMaxVector(features, len, &lowerBound, &upperBound);
+ *   scaleVectorInto(features, features, len, lowerBound, upperBound, 0.0, 1.0);
+ * @endcode
+ */
+void minMaxVector(const float *vector, int vectorLen, float *minOut, float *maxOut)
+{
+    DML_PROFILE_BEGIN(DML_PROF_MIN_MAX_VECTOR, vectorLen);
+
+    float minVal = vector[0];
+    float maxVal = vector[0];
+    int index = 1;
+
+#if defined(DML_SIMD_CMSIS)
+    uint32_t position;
+
+    arm_min_f32(vector, (uint32_t)vectorLen, &minVal, &position);
+    arm_max_f32(vector, (uint32_t)vectorLen, &maxVal, &position);
+    index = vectorLen;
+#elif defined(DML_SIMD_AVX)
+    if(vectorLen >= 8)
+    {
+        __m256 mins = _mm256_loadu_ps(vector);
+        __m256 maxs = mins;
+
+        for(index=8; index+8<=vectorLen; index+=8)
+        {
+            __m256 x = _mm256_loadu_ps(vector + index);
+
+            mins = _mm256_min_ps(mins, x);
+            maxs = _mm256_max_ps(maxs, x);
+        }
+        minVal = sseHorizontalMin(_mm_min_ps(_mm256_castps256_ps128(mins), _mm256_extractf128_ps(mins, 1)));
+        maxVal = sseHorizontalMax(_mm_max_ps(_mm256_castps256_ps128(maxs), _mm256_extractf128_ps(maxs, 1)));
+    }
+#elif defined(DML_SIMD_SSE)
+    if(vectorLen >= 4)
+    {
+        __m128 mins = _mm_loadu_ps(vector);
+        __m128 maxs = mins;
+
+        for(index=4; index+4<=vectorLen; index+=4)
+        {
+            __m128 x = _mm_loadu_ps(vector + index);
+
+            mins = _mm_min_ps(mins, x);
+            maxs = _mm_max_ps(maxs, x);
+        }
+        minVal = sseHorizontalMin(mins);
+        maxVal = sseHorizontalMax(maxs);
+    }
+#elif defined(DML_SIMD_NEON)
+    if(vectorLen >= 4)
+    {
+        float32x4_t mins = vld1q_f32(vector);
+        float32x4_t maxs = mins;
+
+        for(index=4; index+4<=vectorLen; index+=4)
+        {
+            float32x4_t x = vld1q_f32(vector + index);
+
+            mins = vminq_f32(mins, x);
+            maxs = vmaxq_f32(maxs, x);
+        }
+        minVal = neonHorizontalMin(mins);
+        maxVal = neonHorizontalMax(maxs);
+    }
+#endif
+
+    for(; index<vectorLen; index++)
+    {
+        if(*(vector + index) < minVal)
+            minVal = *(vector + index);
+        if(*(vector + index) > maxVal)
+            maxVal = *(vector + index);
+    }
+
+    if(minOut != NULL)
+        *minOut = minVal;
+    if(maxOut != NULL)
+        *maxOut = maxVal;
+
+    DML_PROFILE_END();
+}
+
+/** @brief SIMD dot product of two contiguous vectors. */
+static float dotBlock(const float *a, const float *b, int len)
+{
+    float sum = 0;
+    int index = 0;
+
+#if defined(DML_SIMD_CMSIS)
+    if(len > 0)
+    {
+        float32_t result;
+
+        arm_dot_prod_f32(a, b, (uint32_t)len, &result);
+        return result;
+    }
+#elif defined(DML_SIMD_AVX)
+    __m256 acc0 = _mm256_setzero_ps();
+    __m256 acc1 = _mm256_setzero_ps();
+
+    for(; index+16<=len; index+=16)
+    {
+        acc0 = _mm256_add_ps(acc0, _mm256_mul_ps(_mm256_loadu_ps(a + index), _mm256_loadu_ps(b + index)));
+        acc1 = _mm256_add_ps(acc1, _mm256_mul_ps(_mm256_loadu_ps(a + index + 8), _mm256_loadu_ps(b + index + 8)));
+    }
+    acc0 = _mm256_add_ps(acc0, acc1);
+    sum = sseHorizontalSum(_mm_add_ps(_mm256_castps256_ps128(acc0), _mm256_extractf128_ps(acc0, 1)));
+#elif defined(DML_SIMD_SSE)
+    __m128 acc0 = _mm_setzero_ps();
+    __m128 acc1 = _mm_setzero_ps();
+
+    for(; index+8<=len; index+=8)
+    {
+        acc0 = _mm_add_ps(acc0, _mm_mul_ps(_mm_loadu_ps(a + index), _mm_loadu_ps(b + index)));
+        acc1 = _mm_add_ps(acc1, _mm_mul_ps(_mm_loadu_ps(a + index + 4), _mm_loadu_ps(b + index + 4)));
+    }
+    sum = sseHorizontalSum(_mm_add_ps(acc0, acc1));
+#elif defined(DML_SIMD_NEON)
+    float32x4_t acc0 = vdupq_n_f32(0);
+    float32x4_t acc1 = vdupq_n_f32(0);
+
+    for(; index+8<=len; index+=8)
+    {
+        acc0 = vmlaq_f32(acc0, vld1q_f32(a + index), vld1q_f32(b + index));
+        acc1 = vmlaq_f32(acc1, vld1q_f32(a + index + 4), vld1q_f32(b + index + 4));
+    }
+    sum = neonHorizontalSum(vaddq_f32(acc0, acc1));
+#endif
+
+    for(; index<len; index++)
+        sum += a[index] * b[index];
+
+    return sum;
+}
+
+/** @brief SIMD sum of squared differences of two contiguous vectors. */
+static float squaredDiffBlock(const float *a, const float *b, int len)
+{
+    float sum = 0;
+    int index = 0;
+
+#if defined(DML_SIMD_AVX)
+    __m256 acc = _mm256_setzero_ps();
+
+    for(; index+8<=len; index+=8)
+    {
+        __m256 diff = _mm256_sub_ps(_mm256_loadu_ps(a + index), _mm256_loadu_ps(b + index));
+
+        acc = _mm256_add_ps(acc, _mm256_mul_ps(diff, diff));
+    }
+    sum = sseHorizontalSum(_mm_add_ps(_mm256_castps256_ps128(acc), _mm256_extractf128_ps(acc, 1)));
+#elif defined(DML_SIMD_SSE)
+    __m128 acc = _mm_setzero_ps();
+
+    for(; index+4<=len; index+=4)
+    {
+        __m128 diff = _mm_sub_ps(_mm_loadu_ps(a + index), _mm_loadu_ps(b + index));
+
+        acc = _mm_add_ps(acc, _mm_mul_ps(diff, diff));
+    }
+    sum = sseHorizontalSum(acc);
+#elif defined(DML_SIMD_NEON)
+    float32x4_t acc = vdupq_n_f32(0);
+
+    for(; index+4<=len; index+=4)
+    {
+        float32x4_t diff = vsubq_f32(vld1q_f32(a + index), vld1q_f32(b + index));
+
+        acc = vmlaq_f32(acc, diff, diff);
+    }
+    sum = neonHorizontalSum(acc);
+#endif
+
+    for(; index<len; index++)
+        sum += (a[index] - b[index]) * (a[index] - b[index]);
+
+    return sum;
+}
+
+/** @brief SIMD sum of absolute differences of two contiguous vectors. */
+static float absDiffBlock(const float *a, const float *b, int len)
+{
+    float sum = 0;
+    int index = 0;
+
+#if defined(DML_SIMD_AVX)
+    __m256 signMask = _mm256_set1_ps(-0.0f);
+    __m256 acc = _mm256_setzero_ps();
+
+    for(; index+8<=len; index+=8)
+        acc = _mm256_add_ps(acc, _mm256_andnot_ps(signMask, _mm256_sub_ps(_mm256_loadu_ps(a + index), _mm256_loadu_ps(b + index))));
+    sum = sseHorizontalSum(_mm_add_ps(_mm256_castps256_ps128(acc), _mm256_extractf128_ps(acc, 1)));
+#elif defined(DML_SIMD_SSE)
+    __m128 signMask = _mm_set1_ps(-0.0f);
+    __m128 acc = _mm_setzero_ps();
+
+    for(; index+4<=len; index+=4)
+        acc = _mm_add_ps(acc, _mm_andnot_ps(signMask, _mm_sub_ps(_mm_loadu_ps(a + index), _mm_loadu_ps(b + index))));
+    sum = sseHorizontalSum(acc);
+#elif defined(DML_SIMD_NEON)
+    float32x4_t acc = vdupq_n_f32(0);
+
+    for(; index+4<=len; index+=4)
+        acc = vaddq_f32(acc, vabdq_f32(vld1q_f32(a + index), vld1q_f32(b + index)));
+    sum = neonHorizontalSum(acc);
+#endif
+
+    for(; index<len; index++)
+        sum += fabsf(a[index] - b[index]);
+
+    return sum;
+}
+
+/**
+ * @brief Dot products of four rows 'a[0..3]' with the row 'b', loading 'b' only once.
+ *
+ * This is the register-blocked micro-kernel of 'pairwiseDistances'.
+ */
+static void dotBlock4(const float *const *a, const float *b, int len, float *out)
+{
+    float sum0 = 0, sum1 = 0, sum2 = 0, sum3 = 0;
+    int index = 0;
+
+#if defined(DML_SIMD_AVX)
+    __m256 acc0 = _mm256_setzero_ps(), acc1 = _mm256_setzero_ps();
+    __m256 acc2 = _mm256_setzero_ps(), acc3 = _mm256_setzero_ps();
+
+    for(; index+8<=len; index+=8)
+    {
+        __m256 y = _mm256_loadu_ps(b + index);
+
+        acc0 = _mm256_add_ps(acc0, _mm256_mul_ps(_mm256_loadu_ps(a[0] + index), y));
+        acc1 = _mm256_add_ps(acc1, _mm256_mul_ps(_mm256_loadu_ps(a[1] + index), y));
+        acc2 = _mm256_add_ps(acc2, _mm256_mul_ps(_mm256_loadu_ps(a[2] + index), y));
+        acc3 = _mm256_add_ps(acc3, _mm256_mul_ps(_mm256_loadu_ps(a[3] + index), y));
+    }
+    sum0 = sseHorizontalSum(_mm_add_ps(_mm256_castps256_ps128(acc0), _mm256_extractf128_ps(acc0, 1)));
+    sum1 = sseHorizontalSum(_mm_add_ps(_mm256_castps256_ps128(acc1), _mm256_extractf128_ps(acc1, 1)));
+    sum2 = sseHorizontalSum(_mm_add_ps(_mm256_castps256_ps128(acc2), _mm256_extractf128_ps(acc2, 1)));
+    sum3 = sseHorizontalSum(_mm_add_ps(_mm256_castps256_ps128(acc3), _mm256_extractf128_ps(acc3, 1)));
+#elif defined(DML_SIMD_SSE)
+    __m128 acc0 = _mm_setzero_ps(), acc1 = _mm_setzero_ps();
+    __m128 acc2 = _mm_setzero_ps(), acc3 = _mm_setzero_ps();
+
+    for(; index+4<=len; index+=4)
+    {
+        __m128 y = _mm_loadu_ps(b + index);
+
+        acc0 = _mm_add_ps(acc0, _mm_mul_ps(_mm_loadu_ps(a[0] + index), y));
+        acc1 = _mm_add_ps(acc1, _mm_mul_ps(_mm_loadu_ps(a[1] + index), y));
+        acc2 = _mm_add_ps(acc2, _mm_mul_ps(_mm_loadu_ps(a[2] + index), y));
+        acc3 = _mm_add_ps(acc3, _mm_mul_ps(_mm_loadu_ps(a[3] + index), y));
+    }
+    sum0 = sseHorizontalSum(acc0);
+    sum1 = sseHorizontalSum(acc1);
+    sum2 = sseHorizontalSum(acc2);
+    sum3 = sseHorizontalSum(acc3);
+#elif defined(DML_SIMD_NEON)
+    float32x4_t acc0 = vdupq_n_f32(0), acc1 = vdupq_n_f32(0);
+    float32x4_t acc2 = vdupq_n_f32(0), acc3 = vdupq_n_f32(0);
+
+    for(; index+4<=len; index+=4)
+    {
+        float32x4_t y = vld1q_f32(b + index);
+
+        acc0 = vmlaq_f32(acc0, vld1q_f32(a[0] + index), y);
+        acc1 = vmlaq_f32(acc1, vld1q_f32(a[1] + index), y);
+        acc2 = vmlaq_f32(acc2, vld1q_f32(a[2] + index), y);
+        acc3 = vmlaq_f32(acc3, vld1q_f32(a[3] + index), y);
+    }
+    sum0 = neonHorizontalSum(acc0);
+    sum1 = neonHorizontalSum(acc1);
+    sum2 = neonHorizontalSum(acc2);
+    sum3 = neonHorizontalSum(acc3);
+#endif
+
+    for(; index<len; index++)
+    {
+        sum0 += a[0][index] * b[index];
+        sum1 += a[1][index] * b[index];
+        sum2 += a[2][index] * b[index];
+        sum3 += a[3][index] * b[index];
+    }
+
+    out[0] = sum0;
+    out[1] = sum1;
+    out[2] = sum2;
+    out[3] = sum3;
+}
+
+/**
+ * @brief Calculate the Euclidean (L2) distance between two vectors.
+ *
+ * @param a   A pointer to the first vector.
+ * @param b   A pointer to the second vector.
+ * @param len The length of both vectors.
+ *
+ * @return The Euclidean distance between 'a' and 'b'.
+ *
+ * @note Like the other vector kernels, this function uses the compile-time selected
+ *       SIMD backend (see 'simdBackend').
+ */
+float distanceL2(const float *a, const float *b, int len)
+{
+    return sqrtf(squaredDiffBlock(a, b, len));
+}
+
+/**
+ * @brief Calculate the Manhattan (L1) distance between two vectors.
+ *
+ * @param a   A pointer to the first vector.
+ * @param b   A pointer to the second vector.
+ * @param len The length of both vectors.
+ *
+ * @return The sum of the absolute differences of 'a' and 'b'.
+ */
+float distanceL1(const float *a, const float *b, int len)
+{
+    return absDiffBlock(a, b, len);
+}
+
+/**
+ * @brief Calculate the cosine distance, 1 - cos(angle), between two vectors.
+ *
+ * @param a   A pointer to the first vector.
+ * @param b   A pointer to the second vector.
+ * @param len The length of both vectors.
+ *
+ * @return A value in [0, 2]; 1 if either vector is all zeros.
+ */
+float distanceCosine(const float *a, const float *b, int len)
+{
+    float norms = dotBlock(a, a, len) * dotBlock(b, b, len);
+
+    return (norms > 0) ? 1 - dotBlock(a, b, len) / sqrtf(norms) : 1;
+}
+
+/**
+ * @brief Distance of the given metric from a squared norm pair and a dot product.
+ */
+static float distanceFromDot(dmlMetric metric, float normA, float normB, float dot)
+{
+    float squared;
+
+    if(metric == DML_DIST_COSINE)
+        return (normA * normB > 0) ? 1 - dot / sqrtf(normA * normB) : 1;
+
+    squared = normA + normB - 2 * dot;
+    if(squared < 0)
+        squared = 0;
+
+    return (metric == DML_DIST_L2) ? sqrtf(squared) : squared;
+}
+
+/**
+ * @brief 'distancesToRows' over a columnar view: one pass per column, DML_SUM_BLOCK rows at a time.
+ */
+static void distancesToColumnar(const dmlColumnar_t *view, const float *query, dmlMetric metric, float queryNorm, float *out)
+{
+    float dots[DML_SUM_BLOCK];
+    float norms[DML_SUM_BLOCK];
+
+    for(int first=0; first<view->rows; first+=DML_SUM_BLOCK)
+    {
+        int count = (view->rows - first < DML_SUM_BLOCK) ? view->rows - first : DML_SUM_BLOCK;
+
+        for(int row=0; row<count; row++)
+        {
+            dots[row] = 0;
+            norms[row] = 0;
+        }
+
+        for(int col=0; col<view->cols; col++)
+        {
+            const float *column = view->data + (long)col * view->stride + first;
+            float q = query[col];
+
+            for(int row=0; row<count; row++)
+            {
+                float diff = column[row] - q;
+
+                if(metric == DML_DIST_L1)
+                {
+                    dots[row] += fabsf(diff);
+                }
+                else if(metric == DML_DIST_COSINE)
+                {
+                    dots[row] += column[row] * q;
+                    norms[row] += column[row] * column[row];
+                }
+                else
+                {
+                    dots[row] += diff * diff;
+                }
+            }
+        }
+
+        for(int row=0; row<count; row++)
+        {
+            if(metric == DML_DIST_COSINE)
+                out[first + row] = distanceFromDot(metric, queryNorm, norms[row], dots[row]);
+            else
+                out[first + row] = (metric == DML_DIST_L2) ? sqrtf(dots[row]) : dots[row];
+        }
+    }
+}
+
+/**
+ * @brief Calculate the distance from one query vector to every row of a '.csv' file.
+ *
+ * This is the inner loop of k-nearest-neighbour search and nearest-centroid assignment.
+ * Every row is read once through its row pointer and compared with the SIMD kernels. With
+ * a columnar view attached the distances are accumulated column by column instead.
+ *
+ * @param df     A pointer to the '.csv' file data structure.
+ * @param query  A pointer to 'df->cols' feature values.
+ * @param metric The distance to compute.
+ * @param out    A pointer to 'df->rows' floats receiving the distance to every row.
+ *
+ * @code
+ *   // Example usage:
+ *   float *distances = createFloatVector(data.rows);
+ *   distancesToRows(&data, sample, DML_DIST_L2SQ, distances);
+ *   // Rank 'distances' to find the nearest neighbours of 'sample'...
+ * @endcode
+ */
+void distancesToRows(csvData_t *df, const float *query, dmlMetric metric, float *out)
+{
+    DML_PROFILE_BEGIN(DML_PROF_DISTANCES_TO_ROWS, (long)df->rows * df->cols);
+
+    float queryNorm = (metric == DML_DIST_COSINE) ? dotBlock(query, query, df->cols) : 0;
+    const dmlColumnar_t *view = findColumnar(df);
+
+    if(view != NULL)
+    {
+        distancesToColumnar(view, query, metric, queryNorm, out);
+        DML_PROFILE_END();
+        return;
+    }
+
+    for(int row=0; row<df->rows; row++)
+    {
+        const float *values = df->dataFrame[row];
+
+        switch(metric)
+        {
+            case DML_DIST_L1:
+                out[row] = absDiffBlock(query, values, df->cols);
+                break;
+            case DML_DIST_COSINE:
+                out[row] = distanceFromDot(metric, queryNorm, dotBlock(values, values, df->cols), dotBlock(query, values, df->cols));
+                break;
+            case DML_DIST_L2SQ:
+                out[row] = squaredDiffBlock(query, values, df->cols);
+                break;
+            default:
+                out[row] = sqrtf(squaredDiffBlock(query, values, df->cols));
+                break;
+        }
+    }
+
+    DML_PROFILE_END();
+}
+
+/**
+ * @brief Calculate the distance between every row of 'a' and every row of 'b'.
+ *
+ * The rows are processed in tiles of DML_DIST_BLOCK x DML_DIST_BLOCK so both tiles stay
+ * in cache, four rows of 'a' at a time against each row of 'b'. The L2 and cosine metrics
+ * use ||a||^2 + ||b||^2 - 2 a.b with the squared norms computed once per row, so the inner
+ * loop is a dot product just like a matrix multiplication.
+ *
+ * @param a      A pointer to the first data structure, e.g. the samples.
+ * @param b      A pointer to the second data structure, e.g. the centroids; it must have
+ *               as many columns as 'a'. It may be the same as 'a'.
+ * @param metric The distance to compute.
+ * @param out    A pointer to 'a->rows * b->rows' floats; 'out[i * b->rows + j]' receives
+ *               the distance between row 'i' of 'a' and row 'j' of 'b'.
+ *
+ * @return 0 on success, -1 if the column counts differ, a frame has no row pointers (it
+ *         stands in for a mapped binary file, see 'binaryFrameAsCsv') or memory could not
+ *         be allocated.
+ *
+ * @note Through the norm expansion, L2 distances of nearly identical rows lose relative
+ *       precision; use 'distancesToRows' or 'distanceL2' when that matters.
+ *
+ * @code
+ *   // Example usage (k-means assignment step):
+ *   csvData_t centroids = {centroidRows, k, data.cols, 0};
+ *   float *distances = createFloatVector(data.rows * k);
+ *   pairwiseDistances(&data, &centroids, DML_DIST_L2SQ, distances);
+ * @endcode
+ */
+int pairwiseDistances(const csvData_t *a, const csvData_t *b, dmlMetric metric, float *out)
+{
+    DML_PROFILE_BEGIN(DML_PROF_PAIRWISE_DISTANCES, (long)a->rows * b->rows * a->cols);
+
+    float *normA = NULL;
+    float *normB = NULL;
+    int dims = a->cols;
+
+    if(a->cols != b->cols || a->dataFrame == NULL || b->dataFrame == NULL)
+    {
+        DML_PROFILE_END();
+        return -1;
+    }
+
+    if(metric != DML_DIST_L1)
+    {
+        normA = createFloatVector(a->rows + b->rows > 0 ? a->rows + b->rows : 1);
+        if(normA == NULL)
+        {
+            DML_PROFILE_END();
+            return -1;
+        }
+        normB = normA + a->rows;
+
+        for(int row=0; row<a->rows; row++)
+            normA[row] = dotBlock(a->dataFrame[row], a->dataFrame[row], dims);
+        for(int row=0; row<b->rows; row++)
+            normB[row] = dotBlock(b->dataFrame[row], b->dataFrame[row], dims);
+    }
+
+    for(int i0=0; i0<a->rows; i0+=DML_DIST_BLOCK)
+    {
+        int iEnd = (a->rows - i0 < DML_DIST_BLOCK) ? a->rows : i0 + DML_DIST_BLOCK;
+
+        for(int j0=0; j0<b->rows; j0+=DML_DIST_BLOCK)
+        {
+            int jEnd = (b->rows - j0 < DML_DIST_BLOCK) ? b->rows : j0 + DML_DIST_BLOCK;
+
+            for(int i=i0; i<iEnd; i+=4)
+            {
+                const float *rows[4];
+                int count = (iEnd - i < 4) ? iEnd - i : 4;
+
+                for(int lane=0; lane<4; lane++)
+                    rows[lane] = a->dataFrame[i + (lane < count ? lane : count - 1)];
+
+                for(int j=j0; j<jEnd; j++)
+                {
+                    float dots[4];
+
+                    if(metric == DML_DIST_L1)
+                    {
+                        for(int lane=0; lane<count; lane++)
+                            out[(long)(i + lane) * b->rows + j] = absDiffBlock(rows[lane], b->dataFrame[j], dims);
+                        continue;
+                    }
+
+                    dotBlock4(rows, b->dataFrame[j], dims, dots);
+
+                    for(int lane=0; lane<count; lane++)
+                        out[(long)(i + lane) * b->rows + j] = distanceFromDot(metric, normA[i + lane], normB[j], dots[lane]);
+                }
+            }
+        }
+    }
+
+    dmlFree(normA);
+
+    DML_PROFILE_END();
+    return 0;
+}
+
+/**
+ * @brief Calculate the mean of a specific column in a '.csv' file.
+ *
+ * This function calculates the mean of the values in the specified
+ * column of the provided '.csv' file data structure 'df->dataFrame'.
+ *
+ * @param df  A pointer to the '.csv' file data structure.
+ * @param col The column index for which to calculate the mean.
+ *
+ * @return The mean value of the specified column.
+ *
+ * @note The '.csv' file should contain numerical data accessible via 'dataFrame'.
+ *       The function iterates through all rows of the column and computes the mean.
+ *
+ * @code
+ *   // Example usage:
+ *   csvData_t data = loadCsv(FILE); // Assuming the file has been loaded successfully.
+ *   int targetColumn = 2; // The column for which to calculate the mean.
+ *   float columnMean = mean(&data, targetColumn);
+ *   // Use the 'columnMean'...
+ * @endcode
+ */
+float mean(csvData_t *df, int col)
+{
+    DML_PROFILE_BEGIN(DML_PROF_MEAN, df->rows);
+
+    dmlAccum_t sum;
+    const dmlColumnar_t *view = findColumnar(df);
+
+    if(findStatsCache(df) != NULL)
+    {
+        dmlStats_t stats;
+
+        columnStats(df, col, &stats);
+        DML_PROFILE_END();
+        return stats.mean;
+    }
+
+    if(view != NULL)
+    {
+        sum = accumulateVector(view->data + (long)col * view->stride, view->rows, 0);
+    }
+    else
+    {
+        sumAccumulator_t acc;
+
+        sumAccumulatorInit(&acc);
+
+        for(int row=0; row<df->rows; row+=DML_SUM_BLOCK)
+        {
+            int blockEnd = (df->rows - row < DML_SUM_BLOCK) ? df->rows : row + DML_SUM_BLOCK;
+            dmlAccum_t block = 0;
+
+            for(int index=row; index<blockEnd; index++)
+                block += df->dataFrame[index][col];
+
+            sumAccumulatorAdd(&acc, block);
+        }
+
+        sum = sumAccumulatorResult(&acc);
+    }
+
+    DML_PROFILE_END();
+    return (float)(sum / (dmlAccum_t)df->rows);
+}
+
+/**
+ * @brief Compare two float values for sorting purposes.
+ *
+ * This function is used as a comparison function for sorting float values in ascending order.
+ * It compares two float values pointed to by 'a' and 'b'.
+ *
+ * @param a A pointer to the first float value to compare.
+ * @param b A pointer to the second float value to compare.
+ *
+ * @return An integer value:
+ *         - Less than 0 if the value pointed to by 'a' is less than the value pointed to by 'b'.
+ *         - 0 if the values are equal.
+ *         - Greater than 0 if the value pointed to by 'a' is greater than the value pointed to by 'b'.
+ *
+ * @note This function is designed to be used with sorting functions like 'qsort'.
+ *       It allows sorting an array of float values in ascending order.
+ *
+ * @code
+ *   // Example usage with qsort:
+ *   float values[] = {3.5, 1.2, 2.8, 0.9};
+ *   int numValues = sizeof(values) / sizeof(values[0]);
+ *   qsort(values, numValues, sizeof(float), compareVectors);
+ *   // 'values' will be sorted in ascending order.
+ * @endcode
+ */
+int compareVectors(const void *a, const void *b)
+{
+    return (*(float *)a > *(float *)b) - (*(float *)a < *(float *)b);
+}
+
+/* Ranges at or below this length are finished off with an insertion sort during selection. */
+#define DML_SELECT_CUTOFF 16
+
+static void swapFloats(float *a, float *b)
+{
+    float temp = *a;
+    *a = *b;
+    *b = temp;
+}
+
+/**
+ * @brief Restore the max-heap property of 'heap' starting from index 'node'.
+ */
+static void siftDownMax(float *heap, int heapLen, int node)
+{
+    for(;;)
+    {
+        int largest = node;
+        int leftChild = 2 * node + 1;
+        int rightChild = leftChild + 1;
+
+        if(leftChild < heapLen && heap[leftChild] > heap[largest])
+            largest = leftChild;
+        if(rightChild < heapLen && heap[rightChild] > heap[largest])
+            largest = rightChild;
+        if(largest == node)
+            return;
+
+        swapFloats(heap + node, heap + largest);
+        node = largest;
+    }
+}
+
+/**
+ * @brief Heap based selection, used as the guaranteed O(n log k) fallback of 'selectKth'.
+ */
+static void heapSelect(float *vector, int vectorLen, int k)
+{
+    for(int node=k/2; node>=0; node--)
+        siftDownMax(vector, k + 1, node);
+
+    for(int index=k+1; index<vectorLen; index++)
+    {
+        if(vector[index] < vector[0])
+        {
+            swapFloats(vector, vector + index);
+            siftDownMax(vector, k + 1, 0);
+        }
+    }
+
+    swapFloats(vector, vector + k);
+}
+
+/**
+ * @brief Partially order 'vector' so that 'vector[k]' holds the k-th smallest element.
+ *
+ * Introselect: a quickselect with median-of-three pivots that switches to a heap selection
+ * once the recursion depth exceeds 2*log2(n), so the worst case stays O(n log n) while the
+ * expected cost is O(n). On return every element before 'k' is not greater than 'vector[k]'
+ * and every element after it is not smaller, exactly like C++'s 'std::nth_element'.
+ */
+static void selectKth(float *vector, int vectorLen, int k)
+{
+    int left = 0;
+    int right = vectorLen - 1;
+    int depthLimit = 0;
+
+    for(int len=vectorLen; len>1; len >>= 1)
+        depthLimit += 2;
+
+    while(right - left > DML_SELECT_CUTOFF)
+    {
+        if(depthLimit-- == 0)
+        {
+            heapSelect(vector + left, right - left + 1, k - left);
+            return;
+        }
+
+        int mid = left + (right - left) / 2;
+
+        if(vector[mid] < vector[left])
+            swapFloats(vector + mid, vector + left);
+        if(vector[right] < vector[left])
+            swapFloats(vector + right, vector + left);
+        if(vector[right] < vector[mid])
+            swapFloats(vector + right, vector + mid);
+
+        float pivot = vector[mid];
+        int i = left;
+        int j = right;
+
+        while(i <= j)
+        {
+            while(vector[i] < pivot)
+                i++;
+            while(vector[j] > pivot)
+                j--;
+            if(i <= j)
+            {
+                swapFloats(vector + i, vector + j);
+                i++;
+                j--;
+            }
+        }
+
+        if(k <= j)
+            right = j;
+        else if(k >= i)
+            left = i;
+        else
+            return;
+    }
+
+    for(int index=left+1; index<=right; index++)
+    {
+        float value = vector[index];
+        int hole = index;
+
+        while(hole > left && vector[hole - 1] > value)
+        {
+            vector[hole] = vector[hole - 1];
+            hole--;
+        }
+        vector[hole] = value;
+    }
+}
+
+/**
+ * @brief Restore the max-heap property, ordered by 'compareLabelledRows', of 'heap' from 'node'.
+ */
+static void siftDownLabelled(labelledRow_t *heap, int heapLen, int node)
+{
+    for(;;)
+    {
+        int largest = node;
+        int leftChild = 2 * node + 1;
+        int rightChild = leftChild + 1;
+
+        if(leftChild < heapLen && compareLabelledRows(heap + leftChild, heap + largest) > 0)
+            largest = leftChild;
+        if(rightChild < heapLen && compareLabelledRows(heap + rightChild, heap + largest) > 0)
+            largest = rightChild;
+        if(largest == node)
+            return;
+
+        labelledRow_t swap = heap[node];
+        heap[node] = heap[largest];
+        heap[largest] = swap;
+        node = largest;
+    }
+}
+
+/**
+ * @brief Shared worker of 'topK' and 'topKLargest'; 'sign' is 1 for the smallest, -1 for the largest.
+ *
+ * Small 'k' keep a bounded max-heap of the best 'k' candidates in one pass. Larger 'k'
+ * find the k-th key with 'selectKth' on a scratch copy and collect everything before it.
+ */
+static int topKSigned(const float *vector, int vectorLen, int k, float sign, int *idxOut, float *valOut)
+{
+    labelledRow_t smallHeap[DML_TOPK_HEAP_MAX];
+    labelledRow_t *best = smallHeap;
+    float *scratch = NULL;
+
+    if(k > vectorLen)
+        k = vectorLen;
+    if(k <= 0)
+        return 0;
+
+    if(k <= DML_TOPK_HEAP_MAX)
+    {
+        for(int index=0; index<k; index++)
+        {
+            best[index].label = sign * vector[index];
+            best[index].row = index;
+        }
+        for(int node=k/2-1; node>=0; node--)
+            siftDownLabelled(best, k, node);
+
+        for(int index=k; index<vectorLen; index++)
+        {
+            float key = sign * vector[index];
+
+            if(key < best[0].label)
+            {
+                best[0].label = key;
+                best[0].row = index;
+                siftDownLabelled(best, k, 0);
+            }
+        }
+    }
+    else
+    {
+        int taken = 0;
+        float threshold;
+
+        best = (labelledRow_t *)dmlAlloc(sizeof(labelledRow_t) * k);
+        scratch = createFloatVector(vectorLen);
+        if(best == NULL || scratch == NULL)
+        {
+            dmlFree(scratch);
+            dmlFree(best);
+            return -1;
+        }
+
+        for(int index=0; index<vectorLen; index++)
+            scratch[index] = sign * vector[index];
+        selectKth(scratch, vectorLen, k - 1);
+        threshold = scratch[k - 1];
+
+        for(int index=0; index<vectorLen; index++)
+        {
+            if(sign * vector[index] < threshold)
+            {
+                best[taken].label = sign * vector[index];
+                best[taken++].row = index;
+            }
+        }
+        for(int index=0; index<vectorLen && taken<k; index++)
+        {
+            if(sign * vector[index] == threshold)
+            {
+                best[taken].label = threshold;
+                best[taken++].row = index;
+            }
+        }
+    }
+
+    qsort(best, (size_t)k, sizeof(labelledRow_t), compareLabelledRows);
+
+    for(int index=0; index<k; index++)
+    {
+        if(idxOut != NULL)
+            idxOut[index] = best[index].row;
+        if(valOut != NULL)
+            valOut[index] = sign * best[index].label;
+    }
+
+    dmlFree(scratch);
+    if(best != smallHeap)
+        dmlFree(best);
+
+    return k;
+}
+
+/**
+ * @brief Find the 'k' smallest elements of a vector without sorting all of it.
+ *
+ * For k up to DML_TOPK_HEAP_MAX this function keeps a bounded heap of the best candidates
+ * in a single O(n log k) pass without allocating; for larger k it uses the O(n) introselect
+ * of 'median' on a scratch copy. Only the 'k' results are sorted.
+ *
+ * @param vector    A pointer to the input vector, e.g. distances from 'distancesToRows'.
+ * @param vectorLen The length of the input vector.
+ * @param k         The number of elements to find; it is clamped to 'vectorLen'.
+ * @param idxOut    A pointer to 'k' ints receiving the positions of the elements in
+ *                  'vector', or NULL if not needed.
+ * @param valOut    A pointer to 'k' floats receiving the elements, or NULL if not needed.
+ *
+ * @return The number of elements written, in ascending order with ties broken by
+ *         position, or -1 if the scratch memory for a large 'k' could not be allocated.
+ *
+ * @code
+ *   // Example usage (5 nearest neighbours):
+ *   int neighbours[5];
+ *   distancesToRows(&data, sample, DML_DIST_L2SQ, distances);
+ *   topK(distances, data.rows, 5, neighbours, NULL);
+ * @endcode
+ */
+int topK(const float *vector, int vectorLen, int k, int *idxOut, float *valOut)
+{
+    DML_PROFILE_BEGIN(DML_PROF_TOP_K, vectorLen);
+    int found = topKSigned(vector, vectorLen, k, 1, idxOut, valOut);
+
+    DML_PROFILE_END();
+    return found;
+}
+
+/**
+ * @brief Find the 'k' largest elements of a vector, in descending order; see 'topK'.
+ *
+ * @param vector    A pointer to the input vector, e.g. scores.
+ * @param vectorLen The length of the input vector.
+ * @param k         The number of elements to find; it is clamped to 'vectorLen'.
+ * @param idxOut    A pointer to 'k' ints receiving the positions, or NULL if not needed.
+ * @param valOut    A pointer to 'k' floats receiving the elements, or NULL if not needed.
+ *
+ * @return The number of elements written, or -1 if scratch memory could not be allocated.
+ */
+int topKLargest(const float *vector, int vectorLen, int k, int *idxOut, float *valOut)
+{
+    DML_PROFILE_BEGIN(DML_PROF_TOP_K, vectorLen);
+    int found = topKSigned(vector, vectorLen, k, -1, idxOut, valOut);
+
+    DML_PROFILE_END();
+    return found;
+}
+
+/**
+ * @brief Median of a scratch buffer; the buffer is reordered in the process.
+ */
+static float medianOfVector(float *vector, int vectorLen)
+{
+    int upper = vectorLen / 2;
+
+    if(vectorLen <= 0)
+        return 0;
+
+    selectKth(vector, vectorLen, upper);
+
+    if(vectorLen % 2 == 1)
+        return vector[upper];
+
+    float lowerMiddle;
+
+    minMaxVector(vector, upper, NULL, &lowerMiddle);
+
+    return (lowerMiddle + vector[upper]) / 2;
+}
+
+/**
+ * @brief Value at the fractional rank 'position' (0-based) of a scratch buffer, interpolating
+ *        linearly between the two neighbouring ranks; the buffer is reordered in the process.
+ */
+static float valueAtRank(float *vector, int vectorLen, float position)
+{
+    int lower = (int)position;
+    float fraction = position - (float)lower;
+
+    if(lower >= vectorLen - 1)
+    {
+        lower = vectorLen - 1;
+        fraction = 0;
+    }
+
+    selectKth(vector, vectorLen, lower);
+
+    if(fraction == 0)
+        return vector[lower];
+
+    float next;
+
+    minMaxVector(vector + lower + 1, vectorLen - lower - 1, &next, NULL);
+
+    return vector[lower] + fraction * (next - vector[lower]);
+}
+
+/**
+ * @brief Linearly interpolated 'p'-quantile of a scratch buffer; the buffer is reordered in the process.
+ */
+static float quantileOfVector(float *vector, int vectorLen, float p)
+{
+    if(vectorLen <= 0)
+        return 0;
+
+    if(p < 0)
+        p = 0;
+    if(p > 1)
+        p = 1;
+
+    return valueAtRank(vector, vectorLen, p * (float)(vectorLen - 1));
+}
+
+/**
+ * @brief First, second and third quartile of a scratch buffer; the buffer is reordered in the process.
+ *
+ * After the median has been selected the buffer is split around it, so the lower and
+ * upper quartiles are selected within one half each instead of the whole buffer again.
+ */
+static void quartilesOfVector(float *vector, int vectorLen, float *q1, float *q2, float *q3)
+{
+    float h1 = 0.25f * (float)(vectorLen - 1);
+    float h2 = 0.50f * (float)(vectorLen - 1);
+    float h3 = 0.75f * (float)(vectorLen - 1);
+    int middle = (int)h2;
+
+    if(vectorLen <= 0)
+    {
+        *q1 = *q2 = *q3 = 0;
+        return;
+    }
+
+    *q2 = valueAtRank(vector, vectorLen, h2);
+
+    if((int)h1 + 1 <= middle)
+    {
+        *q1 = valueAtRank(vector, middle + 1, h1);
+        *q3 = valueAtRank(vector + middle, vectorLen - middle, h3 - (float)middle);
+    }
+    else
+    {
+        *q1 = valueAtRank(vector, vectorLen, h1);
+        *q3 = valueAtRank(vector, vectorLen, h3);
+    }
+}
+
+/**
+ * @brief Sorted copy of column 'col' from the statistics cache of 'df', building it on first use.
+ *
+ * @return The sorted column, or NULL if 'df' has no cache or the copy could not be allocated.
+ */
+static const float *cachedSortedColumn(csvData_t *df, int col)
+{
+    dmlStatsCache_t *cache = findStatsCache(df);
+
+    if(cache == NULL)
+        return NULL;
+
+    if(!(cache->valid[col] & DML_CACHE_SORTED))
+    {
+        if(cache->sorted[col] == NULL)
+            cache->sorted[col] = createFloatVector(cache->rows > 0 ? cache->rows : 1);
+        if(cache->sorted[col] == NULL)
+            return NULL;
+
+        gatherColumn(df, col, cache->sorted[col]);
+        qsort(cache->sorted[col], (size_t)cache->rows, sizeof(float), compareVectors);
+        cache->valid[col] |= DML_CACHE_SORTED;
+    }
+
+    return cache->sorted[col];
+}
+
+/**
+ * @brief Linearly interpolated 'p'-quantile of an ascending vector, as 'quantileOfVector'.
+ */
+static float quantileOfSorted(const float *sorted, int sortedLen, float p)
+{
+    if(sortedLen <= 0)
+        return 0;
+
+    if(p < 0)
+        p = 0;
+    if(p > 1)
+        p = 1;
+
+    float position = p * (float)(sortedLen - 1);
+    int lower = (int)position;
+
+    if(lower >= sortedLen - 1)
+        return sorted[sortedLen - 1];
+
+    return sorted[lower] + (position - (float)lower) * (sorted[lower + 1] - sorted[lower]);
+}
+
+/**
+ * @brief Calculate the median of a specific column in a '.csv' file.
+ *
+ * This function calculates the median of the values in the specified column
+ * of the provided '.csv' file data structure 'df->dataFrame'.
+ *
+ * @param df  A pointer to the '.csv' file data structure.
+ * @param col The column index for which to calculate the median.
+ *
+ * @return The median value of the specified column. For an even number of rows
+ *         this is the average of the two middle values. NaN if the temporary copy of
+ *         the column could not be allocated.
+ *
+ * @note The '.csv' file should contain numerical data accessible via 'dataFrame'.
+ *       The function copies the column's values and partially orders the copy with
+ *       a linear-time selection instead of sorting it completely.
+ *
+ * @code
+ *   // Example usage:
+ *   csvData_t data = loadCsv(FILE); // Assuming the file has been loaded successfully.
+ *   int targetColumn = 2; // The column for which to calculate the median.
+ *   float columnMedian = median(&data, targetColumn);
+ *   // Use the 'columnMedian'...
+ * @endcode
+ */
+float median(csvData_t *df, int col)
+{
+    DML_PROFILE_BEGIN(DML_PROF_MEDIAN, df->rows);
+
+    float medianVal = 0;
+    const float *sorted = cachedSortedColumn(df, col);
+
+    if(sorted != NULL)
+    {
+        if(df->rows <= 0)
+        {
+            DML_PROFILE_END();
+            return 0;
+        }
+
+        DML_PROFILE_END();
+        return (df->rows % 2 == 1) ? sorted[df->rows / 2] : (sorted[df->rows / 2 - 1] + sorted[df->rows / 2]) / 2;
+    }
+
+    float *feature = createFloatVector(df->rows);
+
+    if(feature == NULL)
+    {
+        DML_PROFILE_END();
+        return NAN;
+    }
+
+    gatherColumn(df, col, feature);
+
+    medianVal = medianOfVector(feature, df->rows);
+
+    dmlFree(feature);
+
+    DML_PROFILE_END();
+    return medianVal;
+}
+
+/**
+ * @brief Calculate the 'p'-quantile of a specific column in a '.csv' file.
+ *
+ * This function calculates the quantile of the values in the specified column of
+ * 'df->dataFrame', interpolating linearly between the two closest ranks (the same
+ * definition as NumPy's default), so 'quantile(df, col, 0.5)' equals the median.
+ *
+ * @param df  A pointer to the '.csv' file data structure.
+ * @param col The column index for which to calculate the quantile.
+ * @param p   The requested quantile in [0, 1]; values outside are clamped.
+ *
+ * @return The 'p'-quantile of the specified column, or 0 for an empty frame. NaN if
+ *         the temporary copy of the column could not be allocated.
+ *
+ * @note Like 'median', the function works on a temporary copy of the column and
+ *       uses a linear-time selection, so 'df' is left untouched.
+ *
+ * @code
+ *   // Example usage:
+ *   csvData_t data = loadCsv(FILE); // Assuming the file has been loaded successfully.
+ *   float upperQuartile = quantile(&data, 2, 0.75);
+ * @endcode
+ */
+float quantile(csvData_t *df, int col, float p)
+{
+    DML_PROFILE_BEGIN(DML_PROF_QUANTILE, df->rows);
+
+    float quantileVal = 0;
+    const float *sorted = cachedSortedColumn(df, col);
+
+    if(sorted != NULL)
+    {
+        DML_PROFILE_END();
+        return quantileOfSorted(sorted, df->rows, p);
+    }
+
+    float *feature = createFloatVector(df->rows);
+
+    if(feature == NULL)
+    {
+        DML_PROFILE_END();
+        return NAN;
+    }
+
+    gatherColumn(df, col, feature);
+
+    quantileVal = quantileOfVector(feature, df->rows, p);
+
+    dmlFree(feature);
+
+    DML_PROFILE_END();
+    return quantileVal;
+}
+
+/**
+ * @brief Shared worker of 'medianAll' and 'quantileMatrix'; 'ps' == NULL asks for medians.
+ *
+ * Up to DML_GATHER_COLS requested columns are transposed into one scratch buffer per pass
+ * over the row pointers, and the selection then runs on each contiguous slot of it.
+ */
+static int selectColumns(csvData_t *df, const int *cols, int ncols, const float *ps, int nps, float *out)
+{
+    const dmlColumnar_t *view = findColumnar(df);
+    int group = (ncols < DML_GATHER_COLS) ? ncols : DML_GATHER_COLS;
+    float *scratch;
+
+    if(ncols <= 0)
+        return 0;
+
+    scratch = createFloatVector((df->rows > 0 ? df->rows : 1) * group);
+    if(scratch == NULL)
+        return -1;
+
+    for(int first=0; first<ncols; first+=group)
+    {
+        int count = (ncols - first < group) ? ncols - first : group;
+
+        if(view != NULL)
+        {
+            for(int slot=0; slot<count; slot++)
+                gatherColumn(df, cols ? cols[first + slot] : first + slot, scratch + (long)slot * df->rows);
+        }
+        else
+        {
+            for(int row=0; row<df->rows; row++)
+            {
+                const float *values = df->dataFrame[row];
+
+                for(int slot=0; slot<count; slot++)
+                    scratch[(long)slot * df->rows + row] = values[cols ? cols[first + slot] : first + slot];
+            }
+        }
+
+        for(int slot=0; slot<count; slot++)
+        {
+            float *column = scratch + (long)slot * df->rows;
+
+            if(ps == NULL)
+            {
+                out[first + slot] = medianOfVector(column, df->rows);
+                continue;
+            }
+
+            for(int index=0; index<nps; index++)
+                out[(long)(first + slot) * nps + index] = quantileOfVector(column, df->rows, ps[index]);
+        }
+    }
+
+    dmlFree(scratch);
+
+    return 0;
+}
+
+/**
+ * @brief Calculate the median of several columns of a '.csv' file with a single scratch buffer.
+ *
+ * This function gives the same results as calling 'median' for every column, but it
+ * allocates once, and it walks the row pointers of 'df->dataFrame' once for every
+ * DML_GATHER_COLS columns instead of once per column.
+ *
+ * @param df    A pointer to the '.csv' file data structure.
+ * @param cols  The indices of the columns, or NULL for columns 0 to 'ncols' - 1.
+ * @param ncols The number of columns.
+ * @param out   A pointer to 'ncols' floats receiving the medians in the order of 'cols'.
+ *
+ * @return 0 on success, -1 if the scratch buffer could not be allocated.
+ *
+ * @code
+ *   // Example usage:
+ *   csvData_t data = loadCsv(FILE); // Assuming the file has been loaded successfully.
+ *   float *medians = createFloatVector(data.cols);
+ *   medianAll(&data, NULL, data.cols, medians);
+ * @endcode
+ */
+int medianAll(csvData_t *df, const int *cols, int ncols, float *out)
+{
+    DML_PROFILE_BEGIN(DML_PROF_MEDIAN_ALL, (long)ncols * df->rows);
+    int status = selectColumns(df, cols, ncols, NULL, 0, out);
+
+    DML_PROFILE_END();
+    return status;
+}
+
+/**
+ * @brief Calculate several quantiles of several columns of a '.csv' file in one go.
+ *
+ * Like 'medianAll', the columns are transposed into a single scratch buffer; every
+ * quantile is then selected in the partially ordered copy of its column.
+ *
+ * @param df    A pointer to the '.csv' file data structure.
+ * @param cols  The indices of the columns, or NULL for columns 0 to 'ncols' - 1.
+ * @param ncols The number of columns.
+ * @param ps    The 'nps' requested quantiles in [0, 1]; values outside are clamped.
+ * @param nps   The number of quantiles per column.
+ * @param out   A pointer to 'ncols * nps' floats; 'out[c * nps + k]' receives quantile
+ *              'ps[k]' of column 'cols[c]', interpolated as in 'quantile'.
+ *
+ * @return 0 on success, -1 if the scratch buffer could not be allocated.
+ *
+ * @code
+ *   // Example usage:
+ *   float ps[3] = {0.05f, 0.5f, 0.95f};
+ *   float *bands = createFloatVector(data.cols * 3);
+ *   quantileMatrix(&data, NULL, data.cols, ps, 3, bands);
+ * @endcode
+ */
+int quantileMatrix(csvData_t *df, const int *cols, int ncols, const float *ps, int nps, float *out)
+{
+    DML_PROFILE_BEGIN(DML_PROF_QUANTILE_MATRIX, (long)ncols * df->rows);
+    int status = selectColumns(df, cols, ncols, ps, nps, out);
+
+    DML_PROFILE_END();
+    return status;
+}
+
+/**
+ * @brief Calculate the standard deviation of a specific column in a '.csv' file.
+ *
+ * This function calculates the standard deviation of the values in the specified
+ * column of the provided '.csv' file data structure 'df'.
+ *
+ * @param df  A pointer to the '.csv' file data structure.
+ * @param col The column index for which to calculate the standard deviation.
+ *
+ * @return The standard deviation of the specified column.
+ *
+ * @note The '.csv' file should contain numerical data accessible via 'dataFrame'.
+ *       The function computes the variance in a single pass through 'columnStats'
+ *       and returns its square root as the standard deviation.
+ *
+ * @code
+ *   // Example usage:
+ *   csvData_t data = loadCsv(FILE); // Assuming the file has been loaded successfully.
+ *   int targetColumn = 2; // The column for which to calculate the standard deviation.
+ *   float columnStdDev = standardDeviation(&data, targetColumn);
+ *   // Use the 'columnStdDev'...
+ * @endcode
+ */
+float standardDeviation(csvData_t *df, int col)
+{
+    dmlStats_t stats;
+
+    columnStats(df, col, &stats);
+
+    return stats.stdDev;
+}
+
+/**
+ * @brief Calculate count, mean, variance, standard deviation, minimum and maximum of a column in one pass.
+ *
+ * This function walks the specified column of 'df->dataFrame' exactly once and fills 'out'
+ * with all of its summary statistics. The mean and variance are accumulated with Welford's
+ * online algorithm, which avoids the cancellation of the naive sum-of-squares formula and
+ * does not need the mean to be known beforehand.
+ *
+ * @param df  A pointer to the '.csv' file data structure.
+ * @param col The column index for which to calculate the statistics.
+ * @param out A pointer to the structure that receives the statistics.
+ *
+ * @note The variance is the population variance (normalised by the number of rows), which is
+ *       what 'standardDeviation' reports as well. An empty frame yields a zero-filled 'out'.
+ *
+ * @code
+ *   // Example usage:
+ *   csvData_t data = loadCsv(FILE); // Assuming the file has been loaded successfully.
+ *   dmlStats_t stats;
+ *   columnStats(&data, 2, &stats);
+ *   float *scaled = scaleVector(vector, len, stats.min, stats.max, 0.0, 1.0);
+ * @endcode
+ */
+void columnStats(csvData_t *df, int col, dmlStats_t *out)
+{
+    DML_PROFILE_BEGIN(DML_PROF_COLUMN_STATS, df->rows);
+
+    dmlRunningStats_t stats;
+    const dmlColumnar_t *view = findColumnar(df);
+    dmlStatsCache_t *cache = findStatsCache(df);
+
+    if(cache != NULL && (cache->valid[col] & DML_CACHE_MOMENTS))
+    {
+        *out = cache->stats[col];
+        DML_PROFILE_END();
+        return;
+    }
+
+    runningStatsInit(&stats);
+
+    if(view != NULL)
+    {
+        const float *column = view->data + (long)col * view->stride;
+
+        for(int row=0; row<view->rows; row++)
+            runningStatsUpdate(&stats, column[row]);
+    }
+    else
+    {
+        for(int row=0; row<df->rows; row++)
+            runningStatsUpdate(&stats, df->dataFrame[row][col]);
+    }
+
+    runningStatsFinalize(&stats, out);
+
+    if(cache != NULL)
+    {
+        cache->stats[col] = *out;
+        cache->valid[col] |= DML_CACHE_MOMENTS;
+    }
+
+    DML_PROFILE_END();
+}
+
+/**
+ * @brief Initialise (or reset) a running statistics accumulator.
+ *
+ * @param stats A pointer to the accumulator to initialise.
+ */
+void runningStatsInit(dmlRunningStats_t *stats)
+{
+    stats->count = 0;
+    stats->mean = 0;
+    stats->m2 = 0;
+    stats->min = 0;
+    stats->max = 0;
+}
+
+/**
+ * @brief Add one observation to a running statistics accumulator.
+ *
+ * This function updates the mean and the sum of squared differences with Welford's
+ * algorithm, and the minimum and maximum, in O(1) time and memory.
+ *
+ * @param stats A pointer to an initialised accumulator.
+ * @param value The observation to add.
+ *
+ * @code
+ *   // Example usage:
+ *   dmlRunningStats_t stats;
+ *   dmlStats_t result;
+ *   runningStatsInit(&stats);
+ *   while(readSensor(&value))
+ *       runningStatsUpdate(&stats, value);
+ *   runningStatsFinalize(&stats, &result);
+ * @endcode
+ */
+void runningStatsUpdate(dmlRunningStats_t *stats, float value)
+{
+    dmlAccum_t delta = value - stats->mean;
+
+    if(stats->count == 0)
+    {
+        stats->min = value;
+        stats->max = value;
+    }
+    else
+    {
+        if(value < stats->min)
+            stats->min = value;
+        if(value > stats->max)
+            stats->max = value;
+    }
+
+    stats->count++;
+    stats->mean += delta / (dmlAccum_t)stats->count;
+    stats->m2 += delta * (value - stats->mean);
+}
+
+/**
+ * @brief Combine the accumulator 'other' into 'into'.
+ *
+ * This function uses the pairwise update of Chan et al., so statistics gathered
+ * separately (on several devices, threads or data chunks) can be combined without
+ * revisiting any data. The result is the same as if every value seen by 'other' had
+ * been passed to 'runningStatsUpdate' on 'into'.
+ *
+ * @param into  A pointer to the accumulator that receives the combined statistics.
+ * @param other A pointer to the accumulator to fold in; it is not modified.
+ */
+void runningStatsMerge(dmlRunningStats_t *into, const dmlRunningStats_t *other)
+{
+    if(other->count == 0)
+        return;
+
+    if(into->count == 0)
+    {
+        *into = *other;
+        return;
+    }
+
+    long total = into->count + other->count;
+    dmlAccum_t delta = other->mean - into->mean;
+    dmlAccum_t otherShare = (dmlAccum_t)other->count / (dmlAccum_t)total;
+
+    into->mean += delta * otherShare;
+    into->m2 += other->m2 + delta * delta * (dmlAccum_t)into->count * otherShare;
+    into->count = total;
+
+    if(other->min < into->min)
+        into->min = other->min;
+    if(other->max > into->max)
+        into->max = other->max;
+}
+
+/**
+ * @brief Convert a running statistics accumulator into a 'dmlStats_t' summary.
+ *
+ * @param stats A pointer to the accumulator to read.
+ * @param out   A pointer to the structure that receives the statistics.
+ *
+ * @note The accumulator is left unchanged, so more values may be added afterwards.
+ */
+void runningStatsFinalize(const dmlRunningStats_t *stats, dmlStats_t *out)
+{
+    out->count = (int)stats->count;
+    out->mean = (float)stats->mean;
+    out->variance = (stats->count > 0) ? (float)(stats->m2 / (dmlAccum_t)stats->count) : 0;
+    out->stdDev = sqrtf(out->variance);
+    out->min = stats->min;
+    out->max = stats->max;
+}
+
+/**
+ * @brief Initialise (or reset) a streaming quantile sketch.
+ *
+ * @param sketch A pointer to the sketch to initialise.
+ *
+ * @note The sketch does not allocate; it may live on the stack or in a static buffer.
+ */
+void quantileSketchInit(dmlQuantileSketch_t *sketch)
+{
+    sketch->count = 0;
+
+    for(int marker=0; marker<DML_SKETCH_MARKERS; marker++)
+    {
+        sketch->heights[marker] = 0;
+        sketch->positions[marker] = marker + 1;
+    }
+}
+
+/**
+ * @brief Piecewise-parabolic (P-square) prediction of a marker height after moving it by 'step'.
+ */
+static float sketchParabolic(const dmlQuantileSketch_t *sketch, int marker, int step)
+{
+    const float *q = sketch->heights;
+    const long *n = sketch->positions;
+
+    float ahead = (float)(n[marker] - n[marker - 1] + step) * (q[marker + 1] - q[marker])
+                  / (float)(n[marker + 1] - n[marker]);
+    float behind = (float)(n[marker + 1] - n[marker] - step) * (q[marker] - q[marker - 1])
+                   / (float)(n[marker] - n[marker - 1]);
+
+    return q[marker] + (float)step / (float)(n[marker + 1] - n[marker - 1]) * (ahead + behind);
+}
+
+/**
+ * @brief Add one observation to a streaming quantile sketch.
+ *
+ * This function updates the marker heights of 'sketch' in O(DML_SKETCH_MARKERS) time
+ * without storing 'value', so an unlimited number of values can be pushed, e.g. one per
+ * row while a '.csv' file is being read.
+ *
+ * @param sketch A pointer to an initialised sketch.
+ * @param value  The observation to add.
+ *
+ * @code
+ *   // Example usage:
+ *   dmlQuantileSketch_t sketch;
+ *   quantileSketchInit(&sketch);
+ *   while(readSensor(&value))
+ *       quantileSketchPush(&sketch, value);
+ *   float approxMedian = quantileSketchQuery(&sketch, 0.5);
+ * @endcode
+ */
+void quantileSketchPush(dmlQuantileSketch_t *sketch, float value)
+{
+    float *q = sketch->heights;
+    long *n = sketch->positions;
+    int cell = 0;
+
+    if(sketch->count < DML_SKETCH_MARKERS)
+    {
+        int hole = (int)sketch->count;
+
+        while(hole > 0 && q[hole - 1] > value)
+        {
+            q[hole] = q[hole - 1];
+            hole--;
+        }
+        q[hole] = value;
+        sketch->count++;
+        return;
+    }
+
+    if(value < q[0])
+    {
+        q[0] = value;
+    }
+    else if(value >= q[DML_SKETCH_MARKERS - 1])
+    {
+        q[DML_SKETCH_MARKERS - 1] = value;
+        cell = DML_SKETCH_MARKERS - 2;
+    }
+    else
+    {
+        while(value >= q[cell + 1])
+            cell++;
+    }
+
+    for(int marker=cell+1; marker<DML_SKETCH_MARKERS; marker++)
+        n[marker]++;
+
+    sketch->count++;
+
+    for(int marker=1; marker<DML_SKETCH_MARKERS-1; marker++)
+    {
+        float desired = 1 + (float)marker * (float)(sketch->count - 1) / (float)(DML_SKETCH_MARKERS - 1);
+        float delta = desired - (float)n[marker];
+
+        if((delta >= 1 && n[marker + 1] - n[marker] > 1) || (delta <= -1 && n[marker - 1] - n[marker] < -1))
+        {
+            int step = (delta >= 0) ? 1 : -1;
+            float height = sketchParabolic(sketch, marker, step);
+
+            if(!(q[marker - 1] < height && height < q[marker + 1]))
+                height = q[marker] + (float)step * (q[marker + step] - q[marker]) / (float)(n[marker + step] - n[marker]);
+
+            q[marker] = height;
+            n[marker] += step;
+        }
+    }
+}
+
+/**
+ * @brief Estimate the 'p'-quantile of everything pushed into a sketch so far.
+ *
+ * Until DML_SKETCH_MARKERS values have been pushed the answer is exact; afterwards it is
+ * interpolated between the two markers surrounding 'p'. Accuracy is best at the marker
+ * quantiles themselves, which always include the minimum, the median and the maximum.
+ *
+ * @param sketch A pointer to the sketch to query.
+ * @param p      The requested quantile in [0, 1]; values outside are clamped.
+ *
+ * @return The estimated quantile, or 0 if nothing has been pushed yet.
+ */
+float quantileSketchQuery(const dmlQuantileSketch_t *sketch, float p)
+{
+    const float *q = sketch->heights;
+
+    if(sketch->count == 0)
+        return 0;
+
+    if(p < 0)
+        p = 0;
+    if(p > 1)
+        p = 1;
+
+    if(sketch->count < DML_SKETCH_MARKERS)
+    {
+        float position = p * (float)(sketch->count - 1);
+        int lower = (int)position;
+
+        if(lower >= sketch->count - 1)
+            return q[sketch->count - 1];
+
+        return q[lower] + (position - (float)lower) * (q[lower + 1] - q[lower]);
+    }
+
+    float rank = 1 + p * (float)(sketch->count - 1);
+    int marker = 0;
+
+    while(marker < DML_SKETCH_MARKERS - 2 && (float)sketch->positions[marker + 1] < rank)
+        marker++;
+
+    float span = (float)(sketch->positions[marker + 1] - sketch->positions[marker]);
+    float fraction = (rank - (float)sketch->positions[marker]) / span;
+
+    if(fraction < 0)
+        fraction = 0;
+    if(fraction > 1)
+        fraction = 1;
+
+    return q[marker] + fraction * (q[marker + 1] - q[marker]);
+}
+
+/**
+ * @brief Bin code of 'value': the number of inner edges not greater than it.
+ *
+ * The search halves a fixed window with conditional moves only, so it runs in
+ * ceil(log2(numBins)) steps without data-dependent branches.
+ */
+static int binIndex(const dmlBins_t *bins, float value)
+{
+    const float *base = bins->edges + 1;
+    int len = bins->numBins - 1;
+
+    if(len <= 0)
+        return 0;
+
+    while(len > 1)
+    {
+        int half = len / 2;
+
+        base = (base[half] <= value) ? base + half : base;
+        len -= half;
+    }
+
+    return (int)(base - (bins->edges + 1)) + (*base <= value);
+}
+
+/** @brief Rows gathered per 'binCodes' call when binning a row-major column. */
+#define DML_BIN_CHUNK 64
+
+/**
+ * @brief Bin column 'col' chunk by chunk, storing the codes and/or adding them to 'counts'.
+ */
+static void binRows(csvData_t *df, int col, const dmlBins_t *bins, uint8_t *codes, int *counts)
+{
+    const dmlColumnar_t *view = findColumnar(df);
+    float values[DML_BIN_CHUNK];
+    uint8_t chunkCodes[DML_BIN_CHUNK];
+
+    for(int first=0; first<df->rows; first+=DML_BIN_CHUNK)
+    {
+        int count = (df->rows - first < DML_BIN_CHUNK) ? df->rows - first : DML_BIN_CHUNK;
+        const float *chunk = values;
+        uint8_t *target = (codes != NULL) ? codes + first : chunkCodes;
+
+        if(view != NULL)
+        {
+            chunk = view->data + (long)col * view->stride + first;
+        }
+        else
+        {
+            for(int row=0; row<count; row++)
+                values[row] = df->dataFrame[first + row][col];
+        }
+
+        binCodes(bins, chunk, count, target);
+
+        if(counts != NULL)
+        {
+            for(int row=0; row<count; row++)
+                counts[target[row]]++;
+        }
+    }
+}
+
+/**
+ * @brief Build equal-width or equal-frequency bins and the histogram of a column.
+ *
+ * For DML_BIN_WIDTH the edges come from a single pass over the column ('columnStats').
+ * For DML_BIN_QUANTILE they are the exact quantiles of the column, interpolated like
+ * 'quantile', read from one sorted copy of it (or from the sorted column of an attached
+ * statistics cache). A second pass counts the values per bin with the same kernel as
+ * 'binCodes'.
+ *
+ * @param df      A pointer to the '.csv' file data structure.
+ * @param col     The column to bin.
+ * @param numBins The number of bins, from 1 to DML_MAX_BINS.
+ * @param mode    How to place the edges.
+ * @param out     A pointer to the structure receiving edges and counts.
+ *
+ * @return 0 on success, -1 if 'numBins' is out of range or memory could not be allocated.
+ *
+ * @warning The caller must release 'out' with 'freeBins' when it is no longer needed.
+ *
+ * @code
+ *   // Example usage:
+ *   dmlBins_t bins;
+ *   uint8_t *codes = (uint8_t *)malloc(data.rows);
+ *   buildBins(&data, 2, 16, DML_BIN_QUANTILE, &bins);
+ *   binColumn(&data, 2, &bins, codes);
+ *   freeBins(&bins);
+ * @endcode
+ */
+int buildBins(csvData_t *df, int col, int numBins, dmlBinMode mode, dmlBins_t *out)
+{
+    DML_PROFILE_BEGIN(DML_PROF_BUILD_BINS, df->rows);
+
+    if(numBins < 1 || numBins > DML_MAX_BINS)
+    {
+        DML_PROFILE_END();
+        return -1;
+    }
+
+    out->mode = mode;
+    out->numBins = numBins;
+    out->edges = createFloatVector(numBins + 1);
+    out->counts = (int *)dmlAlloc(sizeof(int) * numBins);
+
+    if(out->edges == NULL || out->counts == NULL)
+    {
+        freeBins(out);
+        DML_PROFILE_END();
+        return -1;
+    }
+
+    if(mode == DML_BIN_QUANTILE)
+    {
+        const float *sorted = cachedSortedColumn(df, col);
+        float *column = NULL;
+
+        if(sorted == NULL)
+        {
+            column = createFloatVector(df->rows > 0 ? df->rows : 1);
+            if(column == NULL)
+            {
+                freeBins(out);
+                DML_PROFILE_END();
+                return -1;
+            }
+
+            gatherColumn(df, col, column);
+            qsort(column, (size_t)df->rows, sizeof(float), compareVectors);
+            sorted = column;
+        }
+
+        for(int edge=0; edge<=numBins; edge++)
+            out->edges[edge] = quantileOfSorted(sorted, df->rows, (float)edge / (float)numBins);
+
+        dmlFree(column);
+    }
+    else
+    {
+        dmlStats_t stats;
+
+        columnStats(df, col, &stats);
+
+        for(int edge=0; edge<=numBins; edge++)
+            out->edges[edge] = stats.min + (stats.max - stats.min) * ((float)edge / (float)numBins);
+    }
+
+    for(int bin=0; bin<numBins; bin++)
+        out->counts[bin] = 0;
+    binRows(df, col, out, NULL, out->counts);
+
+    DML_PROFILE_END();
+    return 0;
+}
+
+/**
+ * @brief Release the memory held by bins filled by 'buildBins'.
+ *
+ * @param bins A pointer to the bins to release.
+ */
+void freeBins(dmlBins_t *bins)
+{
+    dmlFree(bins->counts);
+    dmlFree(bins->edges);
+    bins->counts = NULL;
+    bins->edges = NULL;
+    bins->numBins = 0;
+}
+
+/**
+ * @brief Assign every element of a vector to its bin, writing one 'uint8_t' code per element.
+ *
+ * Equal-width bins are assigned with a multiply and a clamp that compilers vectorize;
+ * other bins use a branch-free binary search over the edges.
+ *
+ * @param bins      A pointer to bins filled by 'buildBins'.
+ * @param vector    A pointer to the values to assign.
+ * @param vectorLen The length of 'vector'.
+ * @param codes     A pointer to 'vectorLen' bytes receiving codes in [0, numBins - 1].
+ *
+ * @note NaN values get code 0, like values below 'edges[0]', in both modes.
+ */
+void binCodes(const dmlBins_t *bins, const float *vector, int vectorLen, uint8_t *codes)
+{
+    if(bins->mode == DML_BIN_WIDTH)
+    {
+        float lowest = bins->edges[0];
+        float span = bins->edges[bins->numBins] - lowest;
+        float perBin = (span > 0) ? (float)bins->numBins / span : 0;
+        float lastBin = (float)(bins->numBins - 1);
+
+        for(int index=0; index<vectorLen; index++)
+        {
+            float position = (vector[index] - lowest) * perBin;
+
+            // Written so that NaN, for which every comparison is false, also lands in bin 0.
+            position = !(position > 0) ? 0 : position;
+            position = (position > lastBin) ? lastBin : position;
+            codes[index] = (uint8_t)position;
+        }
+        return;
+    }
+
+    for(int index=0; index<vectorLen; index++)
+        codes[index] = (uint8_t)binIndex(bins, vector[index]);
+}
+
+/**
+ * @brief Assign every value of column 'col' of a '.csv' file to its bin, see 'binCodes'.
+ *
+ * @param df    A pointer to the '.csv' file data structure.
+ * @param col   The column to assign.
+ * @param bins  A pointer to bins filled by 'buildBins', usually for the same column.
+ * @param codes A pointer to 'df->rows' bytes receiving the bin codes.
+ *
+ * @note The codes take a quarter of the memory of the column itself.
+ */
+void binColumn(csvData_t *df, int col, const dmlBins_t *bins, uint8_t *codes)
+{
+    DML_PROFILE_BEGIN(DML_PROF_BIN_COLUMN, df->rows);
+
+    binRows(df, col, bins, codes, NULL);
+
+    DML_PROFILE_END();
+}
+
+/**
+ * @brief Read callback for 'csvStreamInit' that reads from a stdio 'FILE *' context.
+ *
+ * @param context The 'FILE *' to read from.
+ * @param buffer  A pointer to the chunk buffer to fill.
+ * @param size    The capacity of 'buffer' in bytes.
+ *
+ * @return The number of bytes read; 0 at the end of the file or on error.
+ */
+size_t csvReadFile(void *context, char *buffer, size_t size)
+{
+    return fread(buffer, 1, size, (FILE *)context);
+}
+
+/**
+ * @brief Prepare an incremental '.csv' reader that uses only caller-provided memory.
+ *
+ * Unlike 'loadCsv', the stream never holds more than one chunk of text and the row
+ * block passed to 'csvStreamReadRows', so files far larger than the device memory can
+ * be processed from an SD card, a serial link or any other byte source.
+ *
+ * @param stream     A pointer to the stream to initialise.
+ * @param read       The callback fetching the next chunk of text, e.g. 'csvReadFile'.
+ * @param context    The opaque pointer passed to 'read', e.g. a 'FILE *'.
+ * @param buffer     A pointer to the caller's chunk buffer; a few hundred bytes is enough.
+ * @param bufferSize The capacity of 'buffer' in bytes.
+ * @param hasHeader  Non-zero if the first line holds column names and must be skipped.
+ *
+ * @code
+ *   // Example usage:
+ *   char chunk[256];
+ *   dmlCsvStream_t stream;
+ *   FILE *file = fopen("data.csv", "r");
+ *   csvStreamInit(&stream, csvReadFile, file, chunk, sizeof(chunk), 1);
+ * @endcode
+ */
+void csvStreamInit(dmlCsvStream_t *stream, dmlReadFn read, void *context, char *buffer, int bufferSize, int hasHeader)
+{
+    stream->read = read;
+    stream->context = context;
+    stream->buffer = buffer;
+    stream->bufferSize = bufferSize;
+    stream->bufferLen = 0;
+    stream->bufferPos = 0;
+    stream->skipLine = hasHeader;
+    stream->eof = 0;
+}
+
+static int csvStreamGetChar(dmlCsvStream_t *stream)
+{
+    if(stream->bufferPos == stream->bufferLen)
+    {
+        if(stream->eof)
+            return EOF;
+
+        stream->bufferLen = (int)stream->read(stream->context, stream->buffer, (size_t)stream->bufferSize);
+        stream->bufferPos = 0;
+
+        if(stream->bufferLen <= 0)
+        {
+            stream->bufferLen = 0;
+            stream->eof = 1;
+            return EOF;
+        }
+    }
+
+    return (unsigned char)stream->buffer[stream->bufferPos++];
+}
+
+/**
+ * @brief Parse up to 'maxRows' further rows of a '.csv' stream into a row-major block.
+ *
+ * @param stream  A pointer to an initialised stream.
+ * @param block   A pointer to 'maxRows * cols' floats receiving the rows.
+ * @param maxRows The capacity of 'block' in rows.
+ * @param cols    The number of columns to keep; extra fields are ignored and missing or
+ *                non-numeric fields are stored as 0.
+ *
+ * @return The number of rows stored; 0 once the stream is exhausted.
+ *
+ * @note Empty lines are skipped. Fields longer than DML_CSV_FIELD_MAX - 1 characters
+ *       are truncated.
+ */
+int csvStreamReadRows(dmlCsvStream_t *stream, float *block, int maxRows, int cols)
+{
+    char field[DML_CSV_FIELD_MAX];
+    int fieldLen = 0;
+    int fieldIndex = 0;
+    int rows = 0;
+
+    while(rows < maxRows)
+    {
+        int character = csvStreamGetChar(stream);
+
+        if(stream->skipLine)
+        {
+            if(character == '\n' || character == EOF)
+                stream->skipLine = 0;
+            if(character == EOF)
+                break;
+            continue;
+        }
+
+        if(character == ',' || character == '\n' || character == EOF)
+        {
+            if(character != ',' && fieldIndex == 0 && fieldLen == 0)
+            {
+                if(character == EOF)
+                    break;
+                continue;
+            }
+
+            field[fieldLen] = '\0';
+            if(fieldIndex < cols)
+                block[(long)rows * cols + fieldIndex] = strtof(field, NULL);
+            fieldIndex++;
+            fieldLen = 0;
+
+            if(character != ',')
+            {
+                for(; fieldIndex<cols; fieldIndex++)
+                    block[(long)rows * cols + fieldIndex] = 0;
+
+                rows++;
+                fieldIndex = 0;
+
+                if(character == EOF)
+                    break;
+            }
+        }
+        else if(character != '\r' && fieldLen < DML_CSV_FIELD_MAX - 1)
+        {
+            field[fieldLen++] = (char)character;
+        }
+    }
+
+    return rows;
+}
+
+/** @brief Feed 'rows' rows of a row-major block to per-column accumulators. */
+static void accumulateStatsBlock(const float *block, int rows, int cols, dmlRunningStats_t *stats, dmlQuantileSketch_t *sketches)
+{
+    for(int row=0; row<rows; row++)
+    {
+        const float *values = block + (long)row * cols;
+
+        for(int col=0; col<cols; col++)
+        {
+            runningStatsUpdate(stats + col, values[col]);
+            if(sketches != NULL)
+                quantileSketchPush(sketches + col, values[col]);
+        }
+    }
+}
+
+/**
+ * @brief Accumulate per-column statistics of a whole '.csv' stream block by block.
+ *
+ * This function reads the stream to its end in blocks of 'blockRows' rows and feeds
+ * every value into the running statistics and, optionally, the quantile sketch of its
+ * column. Memory use is fixed by the caller's buffers, independent of the file size.
+ *
+ * @param stream    A pointer to an initialised stream.
+ * @param cols      The number of columns in the file.
+ * @param block     A pointer to 'blockRows * cols' floats used as the row block.
+ * @param blockRows The capacity of 'block' in rows.
+ * @param stats     A pointer to 'cols' initialised running statistics accumulators.
+ * @param sketches  A pointer to 'cols' initialised quantile sketches, or NULL.
+ *
+ * @return The number of rows processed.
+ *
+ * @note The accumulators are updated, not reset, so several streams (or chunks of one
+ *       file read on several devices) can be combined with 'runningStatsMerge'.
+ *
+ * @code
+ *   // Example usage:
+ *   float block[4 * 3];
+ *   dmlRunningStats_t stats[3];
+ *   dmlQuantileSketch_t sketches[3];
+ *   dmlStats_t result;
+ *   for(int col=0; col<3; col++)
+ *   {
+ *       runningStatsInit(&stats[col]);
+ *       quantileSketchInit(&sketches[col]);
+ *   }
+ *   streamStats(&stream, 3, block, 4, stats, sketches);
+ *   runningStatsFinalize(&stats[0], &result);
+ *   float firstMedian = quantileSketchQuery(&sketches[0], 0.5);
+ * @endcode
+ */
+long streamStats(dmlCsvStream_t *stream, int cols, float *block, int blockRows, dmlRunningStats_t *stats, dmlQuantileSketch_t *sketches)
+{
+    DML_PROFILE_BEGIN(DML_PROF_STREAM_STATS, 0);
+
+    long total = 0;
+    int rows;
+
+    while((rows = csvStreamReadRows(stream, block, blockRows, cols)) > 0)
+    {
+        accumulateStatsBlock(block, rows, cols, stats, sketches);
+        total += rows;
+    }
+
+    DML_PROFILE_ELEMENTS(total * cols);
+    DML_PROFILE_END();
+    return total;
+}
+
+/**
+ * @brief Shared state of the loader pipeline's producer thread and its consumer.
+ */
+typedef struct pipeline
+{
+    dmlBlockReadFn read;
+    void *readContext;
+    int cols;
+    float *ring;
+    int blockRows;
+    int numBlocks;
+    int slotRows[DML_PIPELINE_MAX_BLOCKS];
+    int head;
+    int tail;
+    int filled;
+    int done;
+#if defined(DML_PIPELINE_PTHREAD)
+    pthread_mutex_t lock;
+    pthread_cond_t notEmpty;
+    pthread_cond_t notFull;
+#endif
+} pipeline_t;
+
+/** @brief Read and consume block after block on the calling thread, reusing the first slot. */
+static long pipelineSerial(pipeline_t *pipe, dmlBlockFn consume, void *consumeContext)
+{
+    long total = 0;
+    int rows;
+
+    while((rows = pipe->read(pipe->readContext, pipe->ring, pipe->blockRows, pipe->cols)) > 0)
+    {
+        consume(consumeContext, pipe->ring, rows, pipe->cols);
+        total += rows;
+    }
+
+    return (rows < 0) ? -1 : total;
+}
+
+#if defined(DML_PIPELINE_PTHREAD)
+/** @brief Ring slot 'slot' of a pipeline. */
+static float *pipelineSlot(const pipeline_t *pipe, int slot)
+{
+    return pipe->ring + (long)slot * pipe->blockRows * pipe->cols;
+}
+
+/** @brief Producer thread: fill free ring slots until the input ends. */
+static void *pipelineProducer(void *arg)
+{
+    pipeline_t *pipe = (pipeline_t *)arg;
+
+    for(;;)
+    {
+        int rows;
+        int slot;
+
+        pthread_mutex_lock(&pipe->lock);
+        while(pipe->filled == pipe->numBlocks)
+            pthread_cond_wait(&pipe->notFull, &pipe->lock);
+        slot = pipe->head;
+        pthread_mutex_unlock(&pipe->lock);
+
+        rows = pipe->read(pipe->readContext, pipelineSlot(pipe, slot), pipe->blockRows, pipe->cols);
+
+        pthread_mutex_lock(&pipe->lock);
+        if(rows > 0)
+        {
+            pipe->slotRows[slot] = rows;
+            pipe->head = (slot + 1) % pipe->numBlocks;
+            pipe->filled++;
+        }
+        else
+        {
+            pipe->done = (rows < 0) ? -1 : 1;
+        }
+        pthread_cond_signal(&pipe->notEmpty);
+        pthread_mutex_unlock(&pipe->lock);
+
+        if(rows <= 0)
+            return NULL;
+    }
+}
+#endif
+
+/**
+ * @brief Run a producer and a consumer of row blocks concurrently over a caller-provided ring.
+ *
+ * With DML_USE_PTHREADS a producer thread keeps up to 'numBlocks' blocks filled through
+ * 'read' while the calling thread hands completed blocks, in input order, to 'consume'.
+ * Parsing (or I/O) and computation therefore overlap, and memory stays bounded by the
+ * ring. Without POSIX threads, or with 'numBlocks' below 2, the blocks are read and
+ * consumed in turn on the calling thread using the first slot only.
+ *
+ * @param read           The producer.
+ * @param readContext    The context passed to 'read'.
+ * @param cols           The number of columns of each row.
+ * @param ring           A pointer to 'numBlocks * blockRows * cols' floats.
+ * @param blockRows      The capacity of one ring slot in rows.
+ * @param numBlocks      The number of ring slots, at most DML_PIPELINE_MAX_BLOCKS.
+ * @param consume        The consumer; it always runs on the calling thread.
+ * @param consumeContext The context passed to 'consume'.
+ *
+ * @return The number of rows consumed, or -1 on invalid arguments or if 'read' failed.
+ *
+ * @note 'read' runs on the producer thread, so it must not share unsynchronised state
+ *       with 'consume'. On microcontrollers, a 'read' that waits for a DMA transfer into
+ *       the slot gives the same double buffering without threads.
+ */
+long pipelineBlocks(dmlBlockReadFn read, void *readContext, int cols, float *ring, int blockRows, int numBlocks, dmlBlockFn consume, void *consumeContext)
+{
+    pipeline_t pipe;
+    long total = 0;
+
+    if(read == NULL || consume == NULL || ring == NULL || cols <= 0 || blockRows <= 0 || numBlocks <= 0 || numBlocks > DML_PIPELINE_MAX_BLOCKS)
+        return -1;
+
+    pipe.read = read;
+    pipe.readContext = readContext;
+    pipe.cols = cols;
+    pipe.ring = ring;
+    pipe.blockRows = blockRows;
+    pipe.numBlocks = numBlocks;
+    pipe.head = 0;
+    pipe.tail = 0;
+    pipe.filled = 0;
+    pipe.done = 0;
+
+#if defined(DML_PIPELINE_PTHREAD)
+    pthread_t producer;
+
+    if(numBlocks < 2)
+        return pipelineSerial(&pipe, consume, consumeContext);
+
+    pthread_mutex_init(&pipe.lock, NULL);
+    pthread_cond_init(&pipe.notEmpty, NULL);
+    pthread_cond_init(&pipe.notFull, NULL);
+
+    if(pthread_create(&producer, NULL, pipelineProducer, &pipe) != 0)
+    {
+        total = pipelineSerial(&pipe, consume, consumeContext);
+    }
+    else
+    {
+        for(;;)
+        {
+            int slot;
+            int rows;
+
+            pthread_mutex_lock(&pipe.lock);
+            while(pipe.filled == 0 && pipe.done == 0)
+                pthread_cond_wait(&pipe.notEmpty, &pipe.lock);
+            if(pipe.filled == 0)
+            {
+                pthread_mutex_unlock(&pipe.lock);
+                break;
+            }
+            slot = pipe.tail;
+            rows = pipe.slotRows[slot];
+            pthread_mutex_unlock(&pipe.lock);
+
+            consume(consumeContext, pipelineSlot(&pipe, slot), rows, cols);
+            total += rows;
+
+            pthread_mutex_lock(&pipe.lock);
+            pipe.tail = (slot + 1) % numBlocks;
+            pipe.filled--;
+            pthread_cond_signal(&pipe.notFull);
+            pthread_mutex_unlock(&pipe.lock);
+        }
+
+        pthread_join(producer, NULL);
+        if(pipe.done < 0)
+            total = -1;
+    }
+
+    pthread_cond_destroy(&pipe.notFull);
+    pthread_cond_destroy(&pipe.notEmpty);
+    pthread_mutex_destroy(&pipe.lock);
+#else
+    total = pipelineSerial(&pipe, consume, consumeContext);
+#endif
+
+    return total;
+}
+
+/** @brief 'dmlBlockReadFn' over a '.csv' stream. */
+static int csvStreamBlockReader(void *context, float *block, int maxRows, int cols)
+{
+    return csvStreamReadRows((dmlCsvStream_t *)context, block, maxRows, cols);
+}
+
+typedef struct streamStatsSink
+{
+    dmlRunningStats_t *stats;
+    dmlQuantileSketch_t *sketches;
+} streamStatsSink_t;
+
+/** @brief 'dmlBlockFn' feeding a block to the accumulators of 'streamStatsPipelined'. */
+static void streamStatsConsumer(void *context, const float *block, int rows, int cols)
+{
+    streamStatsSink_t *sink = (streamStatsSink_t *)context;
+
+    accumulateStatsBlock(block, rows, cols, sink->stats, sink->sketches);
+}
+
+/**
+ * @brief 'streamStats' with parsing overlapped with the statistics updates.
+ *
+ * The stream is parsed on a producer thread into a ring of 'numBlocks' blocks while the
+ * calling thread updates the accumulators; see 'pipelineBlocks'. The results equal those
+ * of 'streamStats', as blocks are consumed in input order.
+ *
+ * @param stream    A pointer to an initialised stream; only the producer reads it.
+ * @param cols      The number of columns in the file.
+ * @param ring      A pointer to 'numBlocks * blockRows * cols' floats.
+ * @param blockRows The capacity of one ring slot in rows.
+ * @param numBlocks The number of ring slots; 2 gives double buffering.
+ * @param stats     A pointer to 'cols' initialised running statistics accumulators.
+ * @param sketches  A pointer to 'cols' initialised quantile sketches, or NULL.
+ *
+ * @return The number of rows processed, or -1 on invalid arguments.
+ *
+ * @code
+ *   // Example usage (double buffering of 256-row blocks):
+ *   static float ring[2 * 256 * 3];
+ *   streamStatsPipelined(&stream, 3, ring, 256, 2, stats, sketches);
+ * @endcode
+ */
+long streamStatsPipelined(dmlCsvStream_t *stream, int cols, float *ring, int blockRows, int numBlocks, dmlRunningStats_t *stats, dmlQuantileSketch_t *sketches)
+{
+    DML_PROFILE_BEGIN(DML_PROF_STREAM_STATS_PIPELINED, 0);
+
+    streamStatsSink_t sink;
+    long total;
+
+    sink.stats = stats;
+    sink.sketches = sketches;
+
+    total = pipelineBlocks(csvStreamBlockReader, stream, cols, ring, blockRows, numBlocks, streamStatsConsumer, &sink);
+
+    DML_PROFILE_ELEMENTS((total > 0) ? total * cols : 0);
+    DML_PROFILE_END();
+    return total;
+}
+
+/**
+ * @brief Write 'in[i] * scale + offset' to 'out[i]'; 'in' and 'out' may be the same buffer.
+ */
+static void affineVectorInto(const float *in, float *out, int vectorLen, float scale, float offset)
+{
+    int loop = 0;
+
+#if defined(DML_SIMD_CMSIS)
+    arm_scale_f32(in, scale, out, (uint32_t)vectorLen);
+    arm_offset_f32(out, offset, out, (uint32_t)vectorLen);
+    loop = vectorLen;
+#elif defined(DML_SIMD_AVX)
+    __m256 scales = _mm256_set1_ps(scale);
+    __m256 offsets = _mm256_set1_ps(offset);
+
+    for(; loop+8<=vectorLen; loop+=8)
+        _mm256_storeu_ps(out + loop, _mm256_add_ps(_mm256_mul_ps(_mm256_loadu_ps(in + loop), scales), offsets));
+#elif defined(DML_SIMD_SSE)
+    __m128 scales = _mm_set1_ps(scale);
+    __m128 offsets = _mm_set1_ps(offset);
+
+    for(; loop+4<=vectorLen; loop+=4)
+        _mm_storeu_ps(out + loop, _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(in + loop), scales), offsets));
+#elif defined(DML_SIMD_NEON)
+    float32x4_t scales = vdupq_n_f32(scale);
+    float32x4_t offsets = vdupq_n_f32(offset);
+
+    for(; loop+4<=vectorLen; loop+=4)
+        vst1q_f32(out + loop, vmlaq_f32(offsets, vld1q_f32(in + loop), scales));
+#endif
+
+    for(; loop<vectorLen; loop++)
+    {
+        *(out + loop) = *(in + loop) * scale + offset;
+    }
+}
+
+/**
+ * @brief Scale a float vector to the range [0, 1] (unity) given custom bounds.
+ *
+ * This function scales each element of the input float vector 'vector' to the
+ * range [0, 1] (unity) based on the specified 'lowerBound' and 'upperBound'.
+ * The scaled values are stored in a dynamically allocated float array.
+ *
+ * @param vector      A pointer to the input float vector to be scaled.
+ * @param vectorLen   The length of the input vector.
+ * @param lowerBound  The lower bound of the desired range.
+ * @param upperBound  The upper bound of the desired range.
+ *
+ * @return A pointer to a dynamically allocated float array containing the scaled values.
+ *         The caller is responsible for freeing the memory allocated for the array
+ *         when it is no longer needed.
+ *
+ * @warning The caller must free the memory allocated for the returned array using
+ *          the 'freeVector' function to prevent memory leaks when it is no longer needed.
+ *
+ * @note The function scales each element of 'vector' individually based on the provided
+ *       'lowerBound' and 'upperBound' values.
+ *
+ * @code
+ *   // Example usage:
+ *   int vectorLength = 5;
+ *   float originalVector[] = {1.0, 2.0, 3.0, 4.0, 5.0};
+ *   float lowerBound = 1.0;
+ *   float upperBound = 5.0;
+ *   float *scaledVector = scaleToUnity(originalVector, vectorLength, lowerBound, upperBound);
+ *   // Use the 'scaledVector'...
+ *   freeVector(scaledVector); // Free the allocated memory when done.
+ * @endcode
+ */
+float *scaleToUnity(float *vector, int vectorLen, float lowerBound, float upperBound)
+{
+    float *unity = (float *)dmlAlloc(sizeof(float) * vectorLen);
+
+    if(unity != NULL)
+        scaleToUnityInto(vector, unity, vectorLen, lowerBound, upperBound);
+
+    return unity;
+}
+
+/**
+ * @brief Scale a float vector to the range [0, 1] (unity) into caller-provided memory.
+ *
+ * This function is the non-allocating form of 'scaleToUnity': each element of 'in'
+ * is mapped from ['lowerBound', 'upperBound'] to [0, 1] and written to 'out'.
+ *
+ * @param in          A pointer to the input float vector to be scaled.
+ * @param out         A pointer to at least 'vectorLen' floats receiving the scaled values.
+ *                    It may be the same pointer as 'in' to scale the vector in place.
+ * @param vectorLen   The length of the input vector.
+ * @param lowerBound  The lower bound of the original range.
+ * @param upperBound  The upper bound of the original range.
+ *
+ * @code
+ *   // Example usage:
+ *   float vector[] = {1.0, 2.0, 3.0, 4.0, 5.0};
+ *   scaleToUnityInto(vector, vector, 5, 1.0, 5.0); // 'vector' is now {0, 0.25, 0.5, 0.75, 1}.
+ * @endcode
+ */
+void scaleToUnityInto(const float *in, float *out, int vectorLen, float lowerBound, float upperBound)
+{
+    DML_PROFILE_BEGIN(DML_PROF_SCALE_TO_UNITY_INTO, vectorLen);
+
+    scaleVectorInto(in, out, vectorLen, lowerBound, upperBound, 0, 1);
+
+    DML_PROFILE_END();
+}
+
+/**
+ * @brief Scale a float vector from one range to another given custom bounds.
+ *
+ * This function scales each element of the input float vector 'vector' from the
+ * range defined by 'lowerBound' and 'upperBound' to a new range defined by
+ * 'newLowBound' and 'newUpBound'. The scaled values are stored in a dynamically
+ * allocated float array.
+ *
+ * @param vector      A pointer to the input float vector to be scaled.
+ * @param vectorLen   The length of the input vector.
+ * @param lowerBound  The lower bound of the original range.
+ * @param upperBound  The upper bound of the original range.
+ * @param newLowBound The lower bound of the new range.
+ * @param newUpBound  The upper bound of the new range.
+ *
+ * @return A pointer to a dynamically allocated float array containing the scaled values.
+ *         The caller is responsible for freeing the memory allocated for the array
+ *         when it is no longer needed.
+ *
+ * @warning The caller must free the memory allocated for the returned array using
+ *          the 'freeVector' function to prevent memory leaks when it is no longer needed.
+ *
+ * @note The function scales each element of 'vector' individually based on the provided
+ *       bounds and computes the scaled values according to the new range.
+ *
+ * @code
+ *   // Example usage:
+ *   int vectorLength = 5;
+ *   float originalVector[] = {1.0, 2.0, 3.0, 4.0, 5.0};
+ *   float lowerBound = 1.0;
+ *   float upperBound = 5.0;
+ *   float newLowerBound = 0.0;
+ *   float newUpperBound = 1.0;
+ *   float *scaledVector = scaleVector(originalVector, vectorLength, lowerBound, upperBound, newLowerBound, newUpperBound);
+ *   // Use the 'scaledVector'...
+ *   freeVector(scaledVector); // Free the allocated memory when done.
+ * @endcode
+ */
+float *scaleVector(float *vector, int vectorLen, float lowerBound, float upperBound, float newLowBound, float newUpBound)
+{
+    float *scaledDownVector = (float *)dmlAlloc(sizeof(float) * vectorLen);
+
+    if(scaledDownVector != NULL)
+        scaleVectorInto(vector, scaledDownVector, vectorLen, lowerBound, upperBound, newLowBound, newUpBound);
+
+    return scaledDownVector;
+}
+
+/**
+ * @brief Scale a float vector from one range to another into caller-provided memory.
+ *
+ * This function is the non-allocating form of 'scaleVector': each element of 'in' is
+ * mapped from ['lowerBound', 'upperBound'] to ['newLowBound', 'newUpBound'] and written
+ * to 'out', so repeated rescaling does not touch the heap at all.
+ *
+ * @param in          A pointer to the input float vector to be scaled.
+ * @param out         A pointer to at least 'vectorLen' floats receiving the scaled values.
+ *                    It may be the same pointer as 'in' to scale the vector in place.
+ * @param vectorLen   The length of the input vector.
+ * @param lowerBound  The lower bound of the original range.
+ * @param upperBound  The upper bound of the original range.
+ * @param newLowBound The lower bound of the new range.
+ * @param newUpBound  The upper bound of the new range.
+ *
+ * @note Apart from 'in == out', the two buffers must not overlap.
+ *
+ * @code
+ *   // Example usage:
+ *   float features[64];
+ *   float scaled[64];
+ *   scaleVectorInto(features, scaled, 64, stats.min, stats.max, -1.0, 1.0);
+ * @endcode
+ */
+void scaleVectorInto(const float *in, float *out, int vectorLen, float lowerBound, float upperBound, float newLowBound, float newUpBound)
+{
+    DML_PROFILE_BEGIN(DML_PROF_SCALE_VECTOR_INTO, vectorLen);
+
+    float scale = (newUpBound - newLowBound) / (upperBound - lowerBound);
+    float offset = newLowBound - (scale * lowerBound);
+
+    affineVectorInto(in, out, vectorLen, scale, offset);
+
+    DML_PROFILE_END();
+}
+
+/**
+ * @brief View a contiguous vector of 'len' floats.
+ *
+ * @param vector A pointer to the first element.
+ * @param len    The number of elements.
+ *
+ * @return The view; no memory is allocated.
+ */
+dmlVectorView_t vectorView(float *vector, int len)
+{
+    return stridedView(vector, len, 1);
+}
+
+/**
+ * @brief View 'len' floats that are 'stride' elements apart, e.g. a column of a row-major block.
+ *
+ * @param base   A pointer to the first element.
+ * @param len    The number of elements.
+ * @param stride The distance between consecutive elements, in floats.
+ *
+ * @return The view; no memory is allocated.
+ */
+dmlVectorView_t stridedView(float *base, int len, long stride)
+{
+    dmlVectorView_t view;
+
+    view.base = base;
+    view.rows = NULL;
+    view.col = 0;
+    view.len = len;
+    view.stride = stride;
+    view.frame = NULL;
+
+    return view;
+}
+
+/**
+ * @brief View column 'col' of a '.csv' file in place, through its row pointers.
+ *
+ * If a columnar view is attached to 'df' the returned view points into its contiguous
+ * copy instead, so the vector kernels run at full SIMD speed.
+ *
+ * @param df  A pointer to the '.csv' file data structure.
+ * @param col The column to view.
+ *
+ * @return The view; no memory is allocated.
+ *
+ * @note As with the other readers of an attached view, writes through such a view change
+ *       the columnar copy, not 'df->dataFrame'.
+ *
+ * @code
+ *   // Example usage (scale column 2 in place, without copying it):
+ *   dmlVectorView_t column = columnView(&data, 2);
+ *   float lowerBound, upperBound;
+ *   minMaxView(&column, &lowerBound, &upperBound);
+ *   scaleViewInto(&column, &column, lowerBound, upperBound, 0.0, 1.0);
+ * @endcode
+ */
+dmlVectorView_t columnView(csvData_t *df, int col)
+{
+    const dmlColumnar_t *columnar = findColumnar(df);
+    dmlVectorView_t view;
+
+    if(columnar != NULL)
+    {
+        view = vectorView(columnar->data + (long)col * columnar->stride, columnar->rows);
+    }
+    else
+    {
+        view.base = NULL;
+        view.rows = df->dataFrame;
+        view.len = df->rows;
+        view.stride = 1;
+    }
+
+    view.col = col;
+    view.frame = df;
+
+    return view;
+}
+
+/** @brief Address of element 'index' of a view. */
+static float *viewAt(const dmlVectorView_t *view, int index)
+{
+    return (view->rows != NULL) ? view->rows[index] + view->col : view->base + index * view->stride;
+}
+
+/**
+ * @brief Elements [first, first + count) of a view as a contiguous array.
+ *
+ * Contiguous views are returned in place; others are gathered into 'chunk', which holds
+ * DML_SUM_BLOCK floats.
+ */
+static const float *viewChunk(const dmlVectorView_t *view, int first, int count, float *chunk)
+{
+    if(view->rows == NULL && view->stride == 1)
+        return view->base + first;
+
+    for(int index=0; index<count; index++)
+        chunk[index] = *viewAt(view, first + index);
+
+    return chunk;
+}
+
+/**
+ * @brief Sum the elements of a view, like 'sumVector'.
+ *
+ * @param view A pointer to the view.
+ *
+ * @return The sum of all elements, or 0 for an empty view.
+ *
+ * @note Non-contiguous views are gathered DML_SUM_BLOCK elements at a time into a stack
+ *       buffer and summed with the same kernels and summation as 'sumVector'.
+ */
+float sumView(const dmlVectorView_t *view)
+{
+    float chunk[DML_SUM_BLOCK];
+    sumAccumulator_t acc;
+
+    sumAccumulatorInit(&acc);
+
+    for(int first=0; first<view->len; first+=DML_SUM_BLOCK)
+    {
+        int count = (view->len - first < DML_SUM_BLOCK) ? view->len - first : DML_SUM_BLOCK;
+
+        sumAccumulatorAdd(&acc, sumBlock(viewChunk(view, first, count, chunk), count));
+    }
+
+    return (float)sumAccumulatorResult(&acc);
+}
+
+/**
+ * @brief Sum the squares of the elements of a view, like 'sumOfSquaresVector'.
+ *
+ * @param view A pointer to the view.
+ *
+ * @return The sum of squared elements, or 0 for an empty view.
+ */
+float sumOfSquaresView(const dmlVectorView_t *view)
+{
+    float chunk[DML_SUM_BLOCK];
+    sumAccumulator_t acc;
+
+    sumAccumulatorInit(&acc);
+
+    for(int first=0; first<view->len; first+=DML_SUM_BLOCK)
+    {
+        int count = (view->len - first < DML_SUM_BLOCK) ? view->len - first : DML_SUM_BLOCK;
+
+        sumAccumulatorAdd(&acc, sumOfSquaresBlock(viewChunk(view, first, count, chunk), count));
+    }
+
+    return (float)sumAccumulatorResult(&acc);
+}
+
+/**
+ * @brief Find the smallest and the largest element of a view, like 'minMaxVector'.
+ *
+ * @param view   A pointer to the view; it must hold at least one element.
+ * @param minOut A pointer receiving the smallest element, or NULL if not needed.
+ * @param maxOut A pointer receiving the largest element, or NULL if not needed.
+ */
+void minMaxView(const dmlVectorView_t *view, float *minOut, float *maxOut)
+{
+    float chunk[DML_SUM_BLOCK];
+    float minVal = *viewAt(view, 0);
+    float maxVal = minVal;
+
+    for(int first=0; first<view->len; first+=DML_SUM_BLOCK)
+    {
+        int count = (view->len - first < DML_SUM_BLOCK) ? view->len - first : DML_SUM_BLOCK;
+        float chunkMin;
+        float chunkMax;
+
+        minMaxVector(viewChunk(view, first, count, chunk), count, &chunkMin, &chunkMax);
+
+        if(chunkMin < minVal)
+            minVal = chunkMin;
+        if(chunkMax > maxVal)
+            maxVal = chunkMax;
+    }
+
+    if(minOut != NULL)
+        *minOut = minVal;
+    if(maxOut != NULL)
+        *maxOut = maxVal;
+}
+
+/**
+ * @brief Scale a view from [lowerBound, upperBound] to [newLowBound, newUpBound], like 'scaleVectorInto'.
+ *
+ * @param in          A pointer to the input view.
+ * @param out         A pointer to the output view of at least 'in->len' elements. It may
+ *                    be the same as 'in' to scale in place, e.g. a column of a frame.
+ * @param lowerBound  The lower bound of the input range.
+ * @param upperBound  The upper bound of the input range.
+ * @param newLowBound The lower bound of the output range.
+ * @param newUpBound  The upper bound of the output range.
+ *
+ * @note When 'out' is a 'columnView', the cached statistics of that column of its frame
+ *       are invalidated.
+ */
+void scaleViewInto(const dmlVectorView_t *in, const dmlVectorView_t *out, float lowerBound, float upperBound, float newLowBound, float newUpBound)
+{
+    float scale = (newUpBound - newLowBound) / (upperBound - lowerBound);
+    float offset = newLowBound - (scale * lowerBound);
+    float chunk[DML_SUM_BLOCK];
+
+    if(out->frame != NULL)
+        invalidateStatsCache(out->frame, out->col);
+
+    for(int first=0; first<in->len; first+=DML_SUM_BLOCK)
+    {
+        int count = (in->len - first < DML_SUM_BLOCK) ? in->len - first : DML_SUM_BLOCK;
+        const float *values = viewChunk(in, first, count, chunk);
+
+        if(out->rows == NULL && out->stride == 1)
+        {
+            affineVectorInto(values, out->base + first, count, scale, offset);
+            continue;
+        }
+
+        affineVectorInto(values, chunk, count, scale, offset);
+        for(int index=0; index<count; index++)
+            *viewAt(out, first + index) = chunk[index];
+    }
+}
+
+/**
+ * @brief Scale a view to [0, 1] given its bounds, like 'scaleToUnityInto'.
+ *
+ * @param in         A pointer to the input view.
+ * @param out        A pointer to the output view; it may be the same as 'in'.
+ * @param lowerBound The lower bound of the input range.
+ * @param upperBound The upper bound of the input range.
+ */
+void scaleToUnityViewInto(const dmlVectorView_t *in, const dmlVectorView_t *out, float lowerBound, float upperBound)
+{
+    scaleViewInto(in, out, lowerBound, upperBound, 0, 1);
+}
+
+/**
+ * @brief Copy the elements of a view into a contiguous buffer.
+ *
+ * @param view A pointer to the view.
+ * @param dst  A pointer to at least 'view->len' floats.
+ */
+void gatherView(const dmlVectorView_t *view, float *dst)
+{
+    for(int index=0; index<view->len; index++)
+        dst[index] = *viewAt(view, index);
+}
+
+/**
+ * @brief Make a frame that covers a range of rows and columns of 'df', without copying data.
+ *
+ * The slice shares the data of 'df', so every function taking a 'csvData_t' (head, tail,
+ * mean, columnStats, describe, ...) works on just the range, in time proportional to it.
+ *
+ * @param df          A pointer to the '.csv' file data structure.
+ * @param firstRow    The first row of the slice; the row range is clipped to the frame.
+ * @param numRows     The number of rows.
+ * @param firstCol    The first column of the slice; the column range is clipped too.
+ * @param numCols     The number of columns.
+ * @param rowPointers When 'firstCol' is 0 this may be NULL and the slice reuses the row
+ *                    pointers of 'df'. Otherwise it must hold 'numRows' pointers, which
+ *                    the slice then uses.
+ * @param out         A pointer to the structure receiving the slice.
+ *
+ * @return 0 on success, -1 if 'rowPointers' is needed but NULL, or if 'df' has no row
+ *         pointers (a stand-in for a mapped binary file).
+ *
+ * @note Columnar views and statistics caches attached to 'df' do not apply to the slice.
+ *
+ * @code
+ *   // Example usage (statistics of the last 100 rows):
+ *   csvData_t recent;
+ *   sliceFrame(&data, data.rows - 100, 100, 0, data.cols, NULL, &recent);
+ *   columnStats(&recent, 2, &stats);
+ * @endcode
+ */
+int sliceFrame(csvData_t *df, int firstRow, int numRows, int firstCol, int numCols, float **rowPointers, csvData_t *out)
+{
+    if(firstRow < 0)
+    {
+        numRows += firstRow;
+        firstRow = 0;
+    }
+    if(firstCol < 0)
+    {
+        numCols += firstCol;
+        firstCol = 0;
+    }
+    if(numRows > df->rows - firstRow)
+        numRows = df->rows - firstRow;
+    if(numCols > df->cols - firstCol)
+        numCols = df->cols - firstCol;
+    if(numRows < 0)
+        numRows = 0;
+    if(numCols < 0)
+        numCols = 0;
+
+    if(df->dataFrame == NULL || (firstCol > 0 && rowPointers == NULL))
+        return -1;
+
+    *out = *df;
+    out->rows = numRows;
+    out->cols = numCols;
+
+    if(firstCol == 0)
+    {
+        out->dataFrame = df->dataFrame + firstRow;
+        return 0;
+    }
+
+    for(int row=0; row<numRows; row++)
+        rowPointers[row] = df->dataFrame[firstRow + row] + firstCol;
+    out->dataFrame = rowPointers;
+
+    return 0;
+}
+
+/**
+ * @brief Create a column-major contiguous copy of a '.csv' file data frame.
+ *
+ * This function copies 'df->dataFrame' into a single dynamically allocated block in
+ * which every column is stored contiguously, padded to a multiple of DML_COLUMNAR_ALIGN
+ * floats. Column reductions over such a block read memory sequentially instead of
+ * dereferencing one row pointer per element.
+ *
+ * @param df A pointer to the '.csv' file data structure.
+ *
+ * @return The columnar copy. Its 'data' member is NULL if the allocation failed.
+ *
+ * @warning The caller must release the copy with 'freeColumnar' when it is no longer needed.
+ *
+ * @code
+ *   // Example usage:
+ *   csvData_t data = loadCsv(FILE); // Assuming the file has been loaded successfully.
+ *   dmlColumnar_t columns = toColumnar(&data);
+ *   attachColumnar(&data, &columns);
+ *   float columnMean = mean(&data, 2); // Reads the contiguous copy.
+ *   detachColumnar(&data);
+ *   freeColumnar(&columns);
+ * @endcode
+ */
+dmlColumnar_t toColumnar(csvData_t *df)
+{
+    DML_PROFILE_BEGIN(DML_PROF_TO_COLUMNAR, (long)df->rows * df->cols);
+
+    dmlColumnar_t view;
+
+    view.rows = df->rows;
+    view.cols = df->cols;
+    view.stride = (df->rows + DML_COLUMNAR_ALIGN - 1) / DML_COLUMNAR_ALIGN * DML_COLUMNAR_ALIGN;
+    view.data = (float *)dmlAlloc(sizeof(float) * (size_t)view.stride * (size_t)view.cols);
+
+    if(view.data == NULL)
+    {
+        DML_PROFILE_END();
+        return view;
+    }
+
+    if(findColumnar(df) != NULL)
+    {
+        for(int col=0; col<df->cols; col++)
+            gatherColumn(df, col, view.data + (long)col * view.stride);
+
+        DML_PROFILE_END();
+        return view;
+    }
+
+    for(int row=0; row<df->rows; row++)
+    {
+        const float *source = df->dataFrame[row];
+
+        for(int col=0; col<df->cols; col++)
+            view.data[(long)col * view.stride + row] = source[col];
+    }
+
+    DML_PROFILE_END();
+    return view;
+}
+
+/**
+ * @brief Copy a columnar view back into the row-of-pointers layout of a data frame.
+ *
+ * @param view A pointer to the columnar copy.
+ * @param df   A pointer to a '.csv' file data structure with the same number of rows and
+ *             columns as 'view'; its 'dataFrame' is overwritten.
+ */
+void columnarToFrame(const dmlColumnar_t *view, csvData_t *df)
+{
+    for(int row=0; row<view->rows; row++)
+    {
+        float *target = df->dataFrame[row];
+
+        for(int col=0; col<view->cols; col++)
+            target[col] = view->data[(long)col * view->stride + row];
+    }
+}
+
+/**
+ * @brief Get a pointer to the first element of a column of a columnar view.
+ *
+ * @param view A pointer to the columnar copy.
+ * @param col  The column index.
+ *
+ * @return A pointer to 'view->rows' contiguous floats holding column 'col'.
+ */
+float *columnarColumn(const dmlColumnar_t *view, int col)
+{
+    return view->data + (long)col * view->stride;
+}
+
+/**
+ * @brief Release the memory held by a columnar view.
+ *
+ * @param view A pointer to the columnar copy; its members are reset afterwards.
+ */
+void freeColumnar(dmlColumnar_t *view)
+{
+    dmlFree(view->data);
+    view->data = NULL;
+    view->rows = 0;
+    view->cols = 0;
+    view->stride = 0;
+}
+
+/**
+ * @brief Make 'mean', 'median', 'quantile', 'standardDeviation', 'columnStats' and
+ *        'randomDataStream' read frame 'df' through a columnar view.
+ *
+ * @param df   A pointer to the '.csv' file data structure.
+ * @param view A pointer to a columnar copy of 'df' (see 'toColumnar'). It is not copied
+ *             and must stay valid until 'detachColumnar' is called.
+ *
+ * @return 0 on success, -1 if the shapes differ or DML_MAX_COLUMNAR_VIEWS views are
+ *         already attached.
+ *
+ * @note While attached, the view is what those functions read, so changes made to
+ *       'df->dataFrame' afterwards are not seen until the view is rebuilt. Attaching and
+ *       detaching is not thread-safe; reading attached frames from several threads is.
+ */
+int attachColumnar(csvData_t *df, const dmlColumnar_t *view)
+{
+    int freeSlot = -1;
+
+    if(view->data == NULL || view->rows != df->rows || view->cols != df->cols)
+        return -1;
+
+    for(int slot=0; slot<DML_MAX_COLUMNAR_VIEWS; slot++)
+    {
+        if(attachedColumnar[slot].df == df)
+        {
+            attachedColumnar[slot].view = view;
+            return 0;
+        }
+        if(freeSlot < 0 && attachedColumnar[slot].df == NULL)
+            freeSlot = slot;
+    }
+
+    if(freeSlot < 0)
+        return -1;
+
+    attachedColumnar[freeSlot].df = df;
+    attachedColumnar[freeSlot].view = view;
+
+    return 0;
+}
+
+/**
+ * @brief Stop reading frame 'df' through its columnar view, if it has one.
+ *
+ * @param df A pointer to the '.csv' file data structure.
+ */
+void detachColumnar(csvData_t *df)
+{
+    for(int slot=0; slot<DML_MAX_COLUMNAR_VIEWS; slot++)
+    {
+        if(attachedColumnar[slot].df == df)
+        {
+            attachedColumnar[slot].df = NULL;
+            attachedColumnar[slot].view = NULL;
+        }
+    }
+}
+
+/**
+ * @brief Memoize the column statistics of frame 'df' in 'cache'.
+ *
+ * While attached, 'mean', 'standardDeviation' and 'columnStats' compute the moments, minimum
+ * and maximum of a column once and then return them in O(1); 'median' and 'quantile' keep a
+ * sorted copy of every column they are asked about and interpolate in it in O(1).
+ *
+ * @param df    A pointer to the '.csv' file data structure.
+ * @param cache A pointer to the cache storage. It must stay valid until 'detachStatsCache'.
+ *
+ * @return 0 on success, -1 if memory could not be allocated or DML_MAX_STATS_CACHES caches
+ *         are already attached.
+ *
+ * @note 'normalizeFrame' and 'applyNormalization' invalidate the cache themselves. After
+ *       changing 'df->dataFrame' (or an attached columnar view) directly, call
+ *       'invalidateStatsCache'. Attaching, detaching and filling the cache is not thread-safe.
+ *
+ * @code
+ *   // Example usage:
+ *   dmlStatsCache_t cache;
+ *   attachStatsCache(&data, &cache);
+ *   float m = mean(&data, 2);               // Scans column 2 once...
+ *   float s = standardDeviation(&data, 2);  // ...and answers from the cache.
+ *   detachStatsCache(&data);
+ * @endcode
+ */
+int attachStatsCache(csvData_t *df, dmlStatsCache_t *cache)
+{
+    int freeSlot = -1;
+
+    for(int slot=0; slot<DML_MAX_STATS_CACHES; slot++)
+    {
+        if(attachedStatsCache[slot].df == df)
+            detachStatsCache(df);
+        if(freeSlot < 0 && attachedStatsCache[slot].df == NULL)
+            freeSlot = slot;
+    }
+
+    if(freeSlot < 0)
+        return -1;
+
+    cache->rows = df->rows;
+    cache->cols = df->cols;
+    cache->stats = (dmlStats_t *)dmlAlloc(sizeof(dmlStats_t) * (df->cols > 0 ? df->cols : 1));
+    cache->sorted = (float **)dmlAlloc(sizeof(float *) * (df->cols > 0 ? df->cols : 1));
+    cache->valid = (unsigned char *)dmlAlloc(df->cols > 0 ? df->cols : 1);
+
+    if(cache->stats == NULL || cache->sorted == NULL || cache->valid == NULL)
+    {
+        dmlFree(cache->valid);
+        dmlFree(cache->sorted);
+        dmlFree(cache->stats);
+        return -1;
+    }
+
+    for(int col=0; col<df->cols; col++)
+    {
+        cache->sorted[col] = NULL;
+        cache->valid[col] = 0;
+    }
+
+    attachedStatsCache[freeSlot].df = df;
+    attachedStatsCache[freeSlot].cache = cache;
+
+    return 0;
+}
+
+/**
+ * @brief Detach the statistics cache of frame 'df', if it has one, and release its memory.
+ *
+ * @param df A pointer to the '.csv' file data structure.
+ */
+void detachStatsCache(csvData_t *df)
+{
+    for(int slot=0; slot<DML_MAX_STATS_CACHES; slot++)
+    {
+        dmlStatsCache_t *cache = attachedStatsCache[slot].cache;
+
+        if(attachedStatsCache[slot].df != df)
+            continue;
+
+        for(int col=cache->cols-1; col>=0; col--)
+            dmlFree(cache->sorted[col]);
+        dmlFree(cache->valid);
+        dmlFree(cache->sorted);
+        dmlFree(cache->stats);
+
+        attachedStatsCache[slot].df = NULL;
+        attachedStatsCache[slot].cache = NULL;
+    }
+}
+
+/**
+ * @brief Forget the cached statistics of column 'col' of frame 'df'.
+ *
+ * @param df  A pointer to the '.csv' file data structure.
+ * @param col The column whose data changed, or -1 for all columns.
+ *
+ * @note Does nothing if 'df' has no statistics cache attached.
+ */
+void invalidateStatsCache(csvData_t *df, int col)
+{
+    dmlStatsCache_t *cache = findStatsCache(df);
+
+    if(cache == NULL)
+        return;
+
+    if(col >= 0)
+    {
+        cache->valid[col] = 0;
+        return;
+    }
+
+    for(int index=0; index<cache->cols; index++)
+        cache->valid[index] = 0;
+}
+
+/**
+ * @brief Write 'row[col] * scale[col] + offset[col]' back to 'row[col]' for every column.
+ */
+static void affineRowInPlace(float *row, const float *scale, const float *offset, int cols)
+{
+    for(int col=0; col<cols; col++)
+        row[col] = row[col] * scale[col] + offset[col];
+}
+
+/**
+ * @brief Normalise every column of a '.csv' file data frame in place.
+ *
+ * This function fits per-column normalisation parameters in one row-major sweep over
+ * 'df->dataFrame' and applies them in a second sweep, instead of computing statistics
+ * and scaling every column separately. The fitted parameters are stored in 'params' so
+ * exactly the same transformation can later be applied to inference data.
+ *
+ * @param df     A pointer to the '.csv' file data structure; its data is overwritten.
+ * @param mode   DML_NORM_MINMAX maps every column onto [0, 1], DML_NORM_ZSCORE gives
+ *               every column zero mean and unit (population) standard deviation.
+ * @param params A pointer to the structure receiving the fitted parameters.
+ *
+ * @return 0 on success, -1 if memory for the parameters could not be allocated.
+ *
+ * @note Constant columns are mapped to 0. If a columnar view is attached to 'df' it is
+ *       normalised too, so both copies stay in sync.
+ *
+ * @warning The caller must release 'params' with 'freeNormParams' when it is no longer needed.
+ *
+ * @code
+ *   // Example usage:
+ *   csvData_t data = loadCsv(FILE); // Assuming the file has been loaded successfully.
+ *   dmlNormParams_t params;
+ *   normalizeFrame(&data, DML_NORM_ZSCORE, &params);
+ *   // ... train on 'data', then for every new sample:
+ *   applyNormalizationRow(sample, &params);
+ *   freeNormParams(&params);
+ * @endcode
+ */
+int normalizeFrame(csvData_t *df, dmlNormMode mode, dmlNormParams_t *params)
+{
+    DML_PROFILE_BEGIN(DML_PROF_NORMALIZE_FRAME, (long)df->rows * df->cols);
+
+    const dmlColumnar_t *view = findColumnar(df);
+    dmlRunningStats_t *stats;
+
+    params->mode = mode;
+    params->cols = df->cols;
+    params->scale = createFloatVector(df->cols);
+    params->offset = createFloatVector(df->cols);
+    stats = (dmlRunningStats_t *)dmlAlloc(sizeof(dmlRunningStats_t) * df->cols);
+
+    if(stats == NULL || params->scale == NULL || params->offset == NULL)
+    {
+        dmlFree(stats);
+        freeNormParams(params);
+        DML_PROFILE_END();
+        return -1;
+    }
+
+    for(int col=0; col<df->cols; col++)
+        runningStatsInit(stats + col);
+
+    for(int row=0; row<df->rows; row++)
+    {
+        if(view != NULL)
+        {
+            for(int col=0; col<df->cols; col++)
+                runningStatsUpdate(stats + col, frameValue(df, view, row, col));
+            continue;
+        }
+
+        for(int col=0; col<df->cols; col++)
+            runningStatsUpdate(stats + col, df->dataFrame[row][col]);
+    }
+
+    for(int col=0; col<df->cols; col++)
+    {
+        float spread = (mode == DML_NORM_ZSCORE)
+                       ? sqrtf(stats[col].count > 0 ? (float)(stats[col].m2 / (dmlAccum_t)stats[col].count) : 0)
+                       : stats[col].max - stats[col].min;
+        float origin = (mode == DML_NORM_ZSCORE) ? (float)stats[col].mean : stats[col].min;
+
+        params->scale[col] = (spread > 0) ? 1 / spread : 0;
+        params->offset[col] = -origin * params->scale[col];
+    }
+
+    dmlFree(stats);
+
+    applyNormalization(df, params);
+
+    DML_PROFILE_END();
+    return 0;
+}
+
+/**
+ * @brief Apply previously fitted normalisation parameters to a whole data frame in place.
+ *
+ * @param df     A pointer to the '.csv' file data structure; it must have 'params->cols' columns.
+ * @param params A pointer to parameters fitted by 'normalizeFrame'.
+ *
+ * @note An attached columnar view is transformed as well, and an attached statistics
+ *       cache is invalidated.
+ */
+void applyNormalization(csvData_t *df, const dmlNormParams_t *params)
+{
+    DML_PROFILE_BEGIN(DML_PROF_APPLY_NORMALIZATION, (long)df->rows * df->cols);
+
+    const dmlColumnar_t *view = findColumnar(df);
+
+    invalidateStatsCache(df, -1);
+
+    for(int row=0; row<df->rows && df->dataFrame != NULL; row++)
+        affineRowInPlace(df->dataFrame[row], params->scale, params->offset, params->cols);
+
+    if(view != NULL)
+    {
+        for(int col=0; col<view->cols; col++)
+        {
+            float *column = view->data + (long)col * view->stride;
+
+            affineVectorInto(column, column, view->rows, params->scale[col], params->offset[col]);
+        }
+    }
+
+    DML_PROFILE_END();
+}
+
+/**
+ * @brief Apply previously fitted normalisation parameters to a single sample in place.
+ *
+ * @param row    A pointer to 'params->cols' feature values, e.g. one inference sample.
+ * @param params A pointer to parameters fitted by 'normalizeFrame'.
+ */
+void applyNormalizationRow(float *row, const dmlNormParams_t *params)
+{
+    affineRowInPlace(row, params->scale, params->offset, params->cols);
+}
+
+/**
+ * @brief Release the memory held by normalisation parameters.
+ *
+ * @param params A pointer to parameters filled by 'normalizeFrame'.
+ */
+void freeNormParams(dmlNormParams_t *params)
+{
+    dmlFree(params->offset);
+    dmlFree(params->scale);
+    params->scale = NULL;
+    params->offset = NULL;
+    params->cols = 0;
+}
+
+#if DML_FIXED_COLS > 0
+/*
+ * Loops over the DML_FIXED_COLS columns carry this hint so they are unrolled completely
+ * even where the compiler would not do it on its own (e.g. at -Os on Cortex-M0).
+ */
+#if defined(__clang__)
+#define DML_UNROLL_FIXED _Pragma("clang loop unroll(full)")
+#elif defined(__GNUC__) && __GNUC__ >= 8
+#define DML_UNROLL_FIXED _Pragma("GCC unroll 64")
+#else
+#define DML_UNROLL_FIXED
+#endif
+
+/**
+ * @brief Copy normalisation parameters fitted by 'normalizeFrame' into inline storage.
+ *
+ * @param params A pointer to fitted parameters of DML_FIXED_COLS columns.
+ * @param out    A pointer to the structure receiving them.
+ *
+ * @return 0 on success, -1 if 'params' has a different number of columns.
+ *
+ * @code
+ *   // Example usage (fit on the host, print a table to compile into the firmware):
+ *   dmlFixedNorm_t norm;
+ *   normalizeFrame(&data, DML_NORM_ZSCORE, &params);
+ *   fixedNormFromParams(&params, &norm);
+ * @endcode
+ */
+int fixedNormFromParams(const dmlNormParams_t *params, dmlFixedNorm_t *out)
+{
+    if(params->cols != DML_FIXED_COLS)
+        return -1;
+
+    DML_UNROLL_FIXED
+    for(int col=0; col<DML_FIXED_COLS; col++)
+    {
+        out->scale[col] = params->scale[col];
+        out->offset[col] = params->offset[col];
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Normalise one sample of DML_FIXED_COLS features, like 'applyNormalizationRow'.
+ *
+ * @param in   A pointer to the sample.
+ * @param out  A pointer receiving the normalised sample; it may be the same as 'in'.
+ * @param norm A pointer to the normalisation, e.g. a constant table in flash.
+ */
+void fixedNormalizeRow(const float *in, float *out, const dmlFixedNorm_t *norm)
+{
+    DML_UNROLL_FIXED
+    for(int col=0; col<DML_FIXED_COLS; col++)
+        out[col] = in[col] * norm->scale[col] + norm->offset[col];
+}
+
+/**
+ * @brief Normalise 'numRows' samples of DML_FIXED_COLS features in place.
+ *
+ * @param rows    A pointer to the samples.
+ * @param numRows The number of samples.
+ * @param norm    A pointer to the normalisation.
+ */
+void fixedApplyNormalization(dmlFixedRow_t *rows, int numRows, const dmlFixedNorm_t *norm)
+{
+    for(int row=0; row<numRows; row++)
+        fixedNormalizeRow(rows[row], rows[row], norm);
+}
+
+/**
+ * @brief Distance of the given metric between two samples of DML_FIXED_COLS features.
+ *
+ * @param a      A pointer to the first sample.
+ * @param b      A pointer to the second sample.
+ * @param metric The distance to compute.
+ *
+ * @return The distance, with the same conventions as 'distanceL2', 'distanceL1' and
+ *         'distanceCosine'.
+ */
+float fixedDistance(const float *a, const float *b, dmlMetric metric)
+{
+    float sum = 0;
+
+    if(metric == DML_DIST_L1)
+    {
+        DML_UNROLL_FIXED
+        for(int col=0; col<DML_FIXED_COLS; col++)
+            sum += fabsf(a[col] - b[col]);
+
+        return sum;
+    }
+
+    if(metric == DML_DIST_COSINE)
+    {
+        float normA = 0;
+        float normB = 0;
+
+        DML_UNROLL_FIXED
+        for(int col=0; col<DML_FIXED_COLS; col++)
+        {
+            sum += a[col] * b[col];
+            normA += a[col] * a[col];
+            normB += b[col] * b[col];
+        }
+
+        return (normA * normB > 0) ? 1 - sum / sqrtf(normA * normB) : 1;
+    }
+
+    DML_UNROLL_FIXED
+    for(int col=0; col<DML_FIXED_COLS; col++)
+    {
+        float diff = a[col] - b[col];
+
+        sum += diff * diff;
+    }
+
+    return (metric == DML_DIST_L2) ? sqrtf(sum) : sum;
+}
+
+/**
+ * @brief Calculate the distance from one query sample to every row of a fixed frame.
+ *
+ * @param frame  A pointer to the frame.
+ * @param query  A pointer to DML_FIXED_COLS feature values.
+ * @param metric The distance to compute.
+ * @param out    A pointer to 'frame->rows' floats receiving the distance to every row.
+ *
+ * @code
+ *   // Example usage (nearest of 16 centroids held in flash):
+ *   static const dmlFixedRow_t centroidTable[16] = { ... };
+ *   const dmlFixedFrame_t centroids = {centroidTable, 16};
+ *   float distances[16];
+ *   fixedDistancesToRows(&centroids, sample, DML_DIST_L2SQ, distances);
+ * @endcode
+ */
+void fixedDistancesToRows(const dmlFixedFrame_t *frame, const float *query, dmlMetric metric, float *out)
+{
+    for(int row=0; row<frame->rows; row++)
+        out[row] = fixedDistance(query, frame->data[row], metric);
+}
+
+/**
+ * @brief Add one sample of DML_FIXED_COLS features to per-column running statistics.
+ *
+ * @param stats A pointer to DML_FIXED_COLS initialised accumulators.
+ * @param row   A pointer to the sample.
+ */
+void fixedStatsUpdate(dmlRunningStats_t *stats, const float *row)
+{
+    DML_UNROLL_FIXED
+    for(int col=0; col<DML_FIXED_COLS; col++)
+        runningStatsUpdate(stats + col, row[col]);
+}
+
+/**
+ * @brief Calculate the statistics of every column of a fixed frame in one pass.
+ *
+ * @param frame A pointer to the frame.
+ * @param out   A pointer to DML_FIXED_COLS structures receiving the statistics.
+ */
+void fixedFrameStats(const dmlFixedFrame_t *frame, dmlStats_t *out)
+{
+    dmlRunningStats_t stats[DML_FIXED_COLS];
+
+    DML_UNROLL_FIXED
+    for(int col=0; col<DML_FIXED_COLS; col++)
+        runningStatsInit(stats + col);
+
+    for(int row=0; row<frame->rows; row++)
+        fixedStatsUpdate(stats, frame->data[row]);
+
+    DML_UNROLL_FIXED
+    for(int col=0; col<DML_FIXED_COLS; col++)
+        runningStatsFinalize(stats + col, out + col);
+}
+#endif
+
+/*
+ * On-disk layout of the binary dataset format: this 64-byte header, then 'cols' column
+ * blocks of 'stride' floats each starting at 'dataOffset', then (when 'statsOffset' is
+ * non-zero) one 'dmlStats_t' per column. Every value uses the byte order and float
+ * format of the machine that wrote the file.
+ */
+#define DML_BINARY_MAGIC   0x424C4D44u /* "DMLB" */
+#define DML_BINARY_VERSION 1u
+#define DML_BINARY_FLOAT32 1u
+#define DML_BINARY_ALIGN   64
+
+typedef struct dmlBinaryHeader
+{
+    uint32_t magic;
+    uint32_t version;
+    uint32_t rows;
+    uint32_t cols;
+    uint32_t dtype;
+    uint32_t stride;
+    uint32_t dataOffset;
+    uint32_t statsOffset;
+    uint32_t reserved[8];
+} dmlBinaryHeader_t;
+
+static int writePadding(FILE *file, long count)
+{
+    static const char zeros[DML_BINARY_ALIGN];
+
+    while(count > 0)
+    {
+        long chunk = (count < DML_BINARY_ALIGN) ? count : DML_BINARY_ALIGN;
+
+        if(fwrite(zeros, 1, (size_t)chunk, file) != (size_t)chunk)
+            return -1;
+        count -= chunk;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Write a '.csv' file data frame in the binary column-major dataset format.
+ *
+ * The file holds a small header, every column as one contiguous block aligned to 64
+ * bytes and, optionally, the 'columnStats' of every column. Opening it again with
+ * 'mapBinaryFrame' needs no parsing at all.
+ *
+ * @param df        A pointer to the '.csv' file data structure.
+ * @param fileName  The path of the file to create or overwrite.
+ * @param withStats Non-zero to precompute and store the statistics of every column.
+ *
+ * @return 0 on success, -1 if the file could not be written.
+ *
+ * @code
+ *   // Example usage:
+ *   csvData_t data = loadCsv("data.csv"); // One-off conversion on the host.
+ *   writeBinaryFrame(&data, "data.dmlb", 1);
+ * @endcode
+ */
+int writeBinaryFrame(csvData_t *df, const char *fileName, int withStats)
+{
+    dmlBinaryHeader_t header;
+    long columnBytes;
+    float *column = createFloatVector(df->rows > 0 ? df->rows : 1);
+    FILE *file = fopen(fileName, "wb");
+    int status = 0;
+
+    if(column == NULL || file == NULL)
+    {
+        dmlFree(column);
+        if(file != NULL)
+            fclose(file);
+        return -1;
+    }
+
+    memset(&header, 0, sizeof(header));
+    header.magic = DML_BINARY_MAGIC;
+    header.version = DML_BINARY_VERSION;
+    header.rows = (uint32_t)df->rows;
+    header.cols = (uint32_t)df->cols;
+    header.dtype = DML_BINARY_FLOAT32;
+    header.stride = (uint32_t)((df->rows + DML_BINARY_ALIGN / 4 - 1) / (DML_BINARY_ALIGN / 4) * (DML_BINARY_ALIGN / 4));
+    header.dataOffset = DML_BINARY_ALIGN;
+    columnBytes = (long)header.stride * (long)sizeof(float);
+    header.statsOffset = withStats ? (uint32_t)(header.dataOffset + columnBytes * df->cols) : 0;
+
+    if(fwrite(&header, sizeof(header), 1, file) != 1 || writePadding(file, DML_BINARY_ALIGN - (long)sizeof(header)) != 0)
+        status = -1;
+
+    for(int col=0; col<df->cols && status==0; col++)
+    {
+        gatherColumn(df, col, column);
+
+        if(fwrite(column, sizeof(float), (size_t)df->rows, file) != (size_t)df->rows
+           || writePadding(file, columnBytes - (long)sizeof(float) * df->rows) != 0)
+            status = -1;
+    }
+
+    for(int col=0; col<df->cols && withStats && status==0; col++)
+    {
+        dmlStats_t stats;
+
+        columnStats(df, col, &stats);
+        if(fwrite(&stats, sizeof(stats), 1, file) != 1)
+            status = -1;
+    }
+
+    dmlFree(column);
+    if(fclose(file) != 0)
+        status = -1;
+
+    return status;
+}
+
+/**
+ * @brief Open a binary dataset written by 'writeBinaryFrame' without parsing it.
+ *
+ * On POSIX systems the file is memory-mapped privately, so opening costs only the
+ * mapping and pages are read on first access. Writes through 'out->view' (for example
+ * 'scaleVectorInto' on a column) stay in memory and never reach the file. On other
+ * systems, or with DML_NO_MMAP defined, the file is read into one heap block instead.
+ *
+ * @param fileName The path of the binary dataset.
+ * @param out      A pointer receiving the opened dataset.
+ *
+ * @return 0 on success, -1 if the file cannot be opened or is not a valid dataset.
+ *
+ * @warning The caller must release the dataset with 'unmapBinaryFrame'.
+ *
+ * @code
+ *   // Example usage:
+ *   dmlBinaryFrame_t bin;
+ *   if(mapBinaryFrame("data.dmlb", &bin) == 0)
+ *   {
+ *       float columnSum = sumVector(columnarColumn(&bin.view, 2), bin.view.rows);
+ *       float columnStd = bin.stats != NULL ? bin.stats[2].stdDev : 0;
+ *       unmapBinaryFrame(&bin);
+ *   }
+ * @endcode
+ */
+int mapBinaryFrame(const char *fileName, dmlBinaryFrame_t *out)
+{
+    DML_PROFILE_BEGIN(DML_PROF_MAP_BINARY_FRAME, 0);
+
+    const dmlBinaryHeader_t *header;
+    size_t length = 0;
+    void *base = NULL;
+    int mapped = 0;
+
+#if defined(DML_HAVE_MMAP)
+    int descriptor = open(fileName, O_RDONLY);
+    struct stat info;
+
+    if(descriptor < 0)
+    {
+        DML_PROFILE_END();
+        return -1;
+    }
+
+    if(fstat(descriptor, &info) == 0 && info.st_size >= (off_t)sizeof(dmlBinaryHeader_t))
+    {
+        length = (size_t)info.st_size;
+        base = mmap(NULL, length, PROT_READ | PROT_WRITE, MAP_PRIVATE, descriptor, 0);
+        if(base == MAP_FAILED)
+            base = NULL;
+        mapped = 1;
+    }
+    close(descriptor);
+#else
+    FILE *file = fopen(fileName, "rb");
+
+    if(file == NULL)
+    {
+        DML_PROFILE_END();
+        return -1;
+    }
+
+    if(fseek(file, 0, SEEK_END) == 0)
+    {
+        long size = ftell(file);
+
+        if(size >= (long)sizeof(dmlBinaryHeader_t) && fseek(file, 0, SEEK_SET) == 0)
+        {
+            length = (size_t)size;
+            base = dmlAlloc(length);
+            if(base != NULL && fread(base, 1, length, file) != length)
+            {
+                dmlFree(base);
+                base = NULL;
+            }
+        }
+    }
+    fclose(file);
+#endif
+
+    if(base == NULL)
+    {
+        DML_PROFILE_END();
+        return -1;
+    }
+
+    out->base = base;
+    out->length = length;
+    out->mapped = mapped;
+
+    header = (const dmlBinaryHeader_t *)base;
+    if(header->magic != DML_BINARY_MAGIC || header->version != DML_BINARY_VERSION
+       || header->dtype != DML_BINARY_FLOAT32 || header->stride < header->rows
+       || (uint64_t)header->dataOffset + (uint64_t)header->stride * header->cols * sizeof(float) > length
+       || (header->statsOffset != 0
+           && (uint64_t)header->statsOffset + (uint64_t)header->cols * sizeof(dmlStats_t) > length))
+    {
+        unmapBinaryFrame(out);
+        DML_PROFILE_END();
+        return -1;
+    }
+
+    out->view.data = (float *)((char *)base + header->dataOffset);
+    out->view.rows = (int)header->rows;
+    out->view.cols = (int)header->cols;
+    out->view.stride = (int)header->stride;
+    out->stats = (header->statsOffset != 0) ? (const dmlStats_t *)((char *)base + header->statsOffset) : NULL;
+
+    DML_PROFILE_ELEMENTS((long)out->view.rows * out->view.cols);
+    DML_PROFILE_END();
+    return 0;
+}
+
+/**
+ * @brief Release a binary dataset opened with 'mapBinaryFrame'.
+ *
+ * @param bin A pointer to the opened dataset; its view must no longer be in use.
+ */
+void unmapBinaryFrame(dmlBinaryFrame_t *bin)
+{
+#if defined(DML_HAVE_MMAP)
+    if(bin->mapped && bin->base != NULL)
+        munmap(bin->base, bin->length);
+#endif
+    if(!bin->mapped)
+        dmlFree(bin->base);
+
+    bin->base = NULL;
+    bin->length = 0;
+    bin->stats = NULL;
+    bin->view.data = NULL;
+    bin->view.rows = 0;
+    bin->view.cols = 0;
+}
+
+/**
+ * @brief Present a mapped binary dataset as a '.csv' frame, without copying it.
+ *
+ * The frame has no row pointers ('dataFrame' is NULL); instead 'bin->view' is attached to
+ * it with 'attachColumnar', and every function reading a frame goes through the view:
+ * head/tail, mean, median, quantiles, column and summary statistics, covariance and
+ * correlation, distances to a query, sampling and batches, bins, quantisation,
+ * 'columnView', 'toColumnar' and the normalisation functions. 'pairwiseDistances' and
+ * 'sliceFrame' need row pointers and return -1; use 'toColumnar' + 'columnarToFrame' to
+ * get a row-major copy for them.
+ *
+ * @param bin A pointer to a dataset opened with 'mapBinaryFrame'.
+ * @param out A pointer to the frame to fill; it must stay at the same address while used.
+ *
+ * @return 0 on success, -1 if DML_MAX_COLUMNAR_VIEWS views are already attached.
+ *
+ * @warning Call 'detachColumnar(out)' before 'unmapBinaryFrame(bin)'.
+ *
+ * @code
+ *   // Example usage:
+ *   dmlBinaryFrame_t bin;
+ *   csvData_t data;
+ *   dmlSummary_t summary[8];
+ *   if(mapBinaryFrame("data.dmlb", &bin) == 0 && binaryFrameAsCsv(&bin, &data) == 0)
+ *   {
+ *       describe(&data, summary);
+ *       detachColumnar(&data);
+ *   }
+ *   unmapBinaryFrame(&bin);
+ * @endcode
+ */
+int binaryFrameAsCsv(dmlBinaryFrame_t *bin, csvData_t *out)
+{
+    memset(out, 0, sizeof(*out));
+    out->dataFrame = NULL;
+    out->rows = bin->view.rows;
+    out->cols = bin->view.cols;
+
+    return attachColumnar(out, &bin->view);
+}
+
+/**
+ * @brief Convert a column of a '.csv' file data frame into 8- or 16-bit integers.
+ *
+ * The column's range [min, max] is mapped linearly onto the full range of the chosen
+ * integer type, so an int8 column takes a quarter and an int16 column half of the memory
+ * of the float column. All statistics and scaling of the result can then run on integer
+ * arithmetic only, e.g. on MCUs without an FPU.
+ *
+ * @param df   A pointer to the '.csv' file data structure.
+ * @param col  The column index to quantize.
+ * @param type DML_QUANT_INT8 or DML_QUANT_INT16.
+ * @param out  A pointer receiving the quantized column.
+ *
+ * @return 0 on success, -1 if the storage could not be allocated.
+ *
+ * @warning The caller must release the column with 'freeQuantColumn'.
+ *
+ * @code
+ *   // Example usage (on the host, before deployment):
+ *   dmlQuantColumn_t feature;
+ *   quantizeColumn(&data, 2, DML_QUANT_INT8, &feature);
+ * @endcode
+ */
+int quantizeColumn(csvData_t *df, int col, dmlQuantType type, dmlQuantColumn_t *out)
+{
+    DML_PROFILE_BEGIN(DML_PROF_QUANTIZE_COLUMN, df->rows);
+
+    dmlStats_t stats;
+    int32_t low = (type == DML_QUANT_INT8) ? INT8_MIN : INT16_MIN;
+    int32_t high = (type == DML_QUANT_INT8) ? INT8_MAX : INT16_MAX;
+    size_t elementSize = (type == DML_QUANT_INT8) ? sizeof(int8_t) : sizeof(int16_t);
+    const dmlColumnar_t *view = findColumnar(df);
+
+    columnStats(df, col, &stats);
+
+    out->type = type;
+    out->rows = df->rows;
+    out->scale = (stats.max - stats.min) / (float)(high - low);
+    if(!(out->scale > 0))
+        out->scale = (stats.min != 0) ? fabsf(stats.min) : 1;
+    out->zeroPoint = low - (int32_t)lroundf(stats.min / out->scale);
+    out->data = dmlAlloc(elementSize * (df->rows > 0 ? df->rows : 1));
+
+    if(out->data == NULL)
+    {
+        DML_PROFILE_END();
+        return -1;
+    }
+
+    for(int row=0; row<df->rows; row++)
+    {
+        long value = lroundf(frameValue(df, view, row, col) / out->scale) + out->zeroPoint;
+
+        if(value < low)
+            value = low;
+        if(value > high)
+            value = high;
+
+        if(type == DML_QUANT_INT8)
+            ((int8_t *)out->data)[row] = (int8_t)value;
+        else
+            ((int16_t *)out->data)[row] = (int16_t)value;
+    }
+
+    DML_PROFILE_END();
+    return 0;
+}
+
+/**
+ * @brief Release the storage of a quantized column.
+ *
+ * @param column A pointer to a column filled by 'quantizeColumn'.
+ */
+void freeQuantColumn(dmlQuantColumn_t *column)
+{
+    dmlFree(column->data);
+    column->data = NULL;
+    column->rows = 0;
+}
+
+static int32_t quantAt(const dmlQuantColumn_t *column, int row)
+{
+    return (column->type == DML_QUANT_INT8) ? ((const int8_t *)column->data)[row]
+                                            : ((const int16_t *)column->data)[row];
+}
+
+/**
+ * @brief Convert a quantized column back to floats.
+ *
+ * @param column A pointer to the quantized column.
+ * @param out    A pointer to at least 'column->rows' floats receiving the real values.
+ */
+void dequantizeInto(const dmlQuantColumn_t *column, float *out)
+{
+    for(int row=0; row<column->rows; row++)
+        *(out + row) = column->scale * (float)(quantAt(column, row) - column->zeroPoint);
+}
+
+/**
+ * @brief Calculate mean, variance, minimum and maximum of a quantized column with integers only.
+ *
+ * The sum is accumulated in 64 bits, and the variance is taken around the rounded mean
+ * and then corrected for the rounding, so the result is exact up to the final rounding
+ * regardless of the column length. No floating-point operation is performed.
+ *
+ * @param column A pointer to the quantized column.
+ * @param out    A pointer receiving the statistics in stored units; convert them with
+ *               'quantStatsToReal' when real values are needed.
+ */
+void quantColumnStats(const dmlQuantColumn_t *column, dmlQuantStats_t *out)
+{
+    DML_PROFILE_BEGIN(DML_PROF_QUANT_COLUMN_STATS, column->rows);
+
+    int64_t sum = 0;
+    int64_t squares = 0;
+    int64_t rows = column->rows;
+    int32_t minVal = 0;
+    int32_t maxVal = 0;
+
+    out->count = column->rows;
+
+    if(column->rows == 0)
+    {
+        out->mean = 0;
+        out->variance = 0;
+        out->min = 0;
+        out->max = 0;
+        DML_PROFILE_END();
+        return;
+    }
+
+    minVal = quantAt(column, 0);
+    maxVal = minVal;
+
+    for(int row=0; row<column->rows; row++)
+    {
+        int32_t value = quantAt(column, row);
+
+        sum += value;
+        if(value < minVal)
+            minVal = value;
+        if(value > maxVal)
+            maxVal = value;
+    }
+
+    int64_t rounded = (sum >= 0) ? (sum + rows / 2) / rows : -((-sum + rows / 2) / rows);
+    int64_t residual = sum - rounded * rows;
+
+    for(int row=0; row<column->rows; row++)
+    {
+        int64_t distance = quantAt(column, row) - rounded;
+
+        squares += distance * distance;
+    }
+
+    out->mean = (int32_t)rounded;
+    out->variance = (uint32_t)((squares - residual * residual / rows) / rows);
+    out->min = minVal;
+    out->max = maxVal;
+
+    DML_PROFILE_END();
+}
+
+/**
+ * @brief Convert statistics in stored units into real-valued 'dmlStats_t'.
+ *
+ * @param column A pointer to the quantized column the statistics belong to.
+ * @param stats  A pointer to statistics filled by 'quantColumnStats'.
+ * @param out    A pointer receiving the real-valued statistics.
+ */
+void quantStatsToReal(const dmlQuantColumn_t *column, const dmlQuantStats_t *stats, dmlStats_t *out)
+{
+    out->count = stats->count;
+    out->mean = column->scale * (float)(stats->mean - column->zeroPoint);
+    out->variance = column->scale * column->scale * (float)stats->variance;
+    out->stdDev = sqrtf(out->variance);
+    out->min = column->scale * (float)(stats->min - column->zeroPoint);
+    out->max = column->scale * (float)(stats->max - column->zeroPoint);
+}
+
+/**
+ * @brief Rescale a quantized column from one integer range to another with integers only.
+ *
+ * This function is the integer counterpart of 'scaleVectorInto': every stored value is
+ * mapped from ['lowerBound', 'upperBound'] onto ['newLowBound', 'newUpBound'] with a
+ * 16.16 fixed-point multiplier and rounding, and the result is saturated to int16.
+ *
+ * @param column      A pointer to the quantized column.
+ * @param out         A pointer to at least 'column->rows' int16 values receiving the result.
+ * @param lowerBound  The lower bound of the original range, in stored units.
+ * @param upperBound  The upper bound of the original range, in stored units.
+ * @param newLowBound The lower bound of the new range.
+ * @param newUpBound  The upper bound of the new range.
+ *
+ * @code
+ *   // Example usage: min-max scale an int8 column onto Q15 [0, 1).
+ *   dmlQuantStats_t stats;
+ *   quantColumnStats(&feature, &stats);
+ *   quantScaleInto(&feature, scaled, stats.min, stats.max, 0, 32767);
+ * @endcode
+ */
+void quantScaleInto(const dmlQuantColumn_t *column, int16_t *out, int32_t lowerBound, int32_t upperBound, int16_t newLowBound, int16_t newUpBound)
+{
+    int32_t span = upperBound - lowerBound;
+    int64_t multiplier = (span != 0) ? ((int64_t)(newUpBound - newLowBound) * 65536) / span : 0;
+
+    for(int row=0; row<column->rows; row++)
+    {
+        int64_t value = newLowBound + (((int64_t)(quantAt(column, row) - lowerBound) * multiplier + 32768) >> 16);
+
+        if(value < INT16_MIN)
+            value = INT16_MIN;
+        if(value > INT16_MAX)
+            value = INT16_MAX;
+
+        *(out + row) = (int16_t)value;
+    }
+}
+
+/**
+ * @brief Position of element (i, j) of a symmetric 'cols' x 'cols' matrix in packed storage.
+ *
+ * @param i    The row of the element.
+ * @param j    The column of the element; (i, j) and (j, i) map to the same position.
+ * @param cols The dimension of the matrix.
+ *
+ * @return The index into the upper triangle stored row by row.
+ */
+long packedIndex(int i, int j, int cols)
+{
+    if(i > j)
+    {
+        int swap = i;
+        i = j;
+        j = swap;
+    }
+
+    return (long)i * cols - (long)i * (i - 1) / 2 + (j - i);
+}
+
+/**
+ * @brief Initialise a covariance accumulator for rows of 'cols' features.
+ *
+ * @param cov  A pointer to the accumulator to initialise.
+ * @param cols The number of features per row.
+ *
+ * @return 0 on success, -1 if memory could not be allocated.
+ *
+ * @warning The caller must release it with 'freeCovariance' when it is no longer needed.
+ *
+ * @code
+ *   // Example usage (out-of-core):
+ *   dmlCovariance_t cov;
+ *   covarianceInit(&cov, cols);
+ *   while((rows = csvStreamReadRows(&stream, block, blockRows, cols)) > 0)
+ *       covarianceUpdateRows(&cov, block, rows);
+ *   correlationFinalize(&cov, correlation);
+ *   freeCovariance(&cov);
+ * @endcode
+ */
+int covarianceInit(dmlCovariance_t *cov, int cols)
+{
+    long packed = (long)cols * (cols + 1) / 2;
+
+    cov->cols = cols;
+    cov->count = 0;
+    cov->blockRows = 0;
+    cov->mean = (dmlAccum_t *)dmlAlloc(sizeof(dmlAccum_t) * (size_t)(cols + packed > 0 ? cols + packed : 1));
+    cov->block = createFloatVector((DML_COV_BLOCK + 1) * (cols > 0 ? cols : 1));
+
+    if(cov->mean == NULL || cov->block == NULL)
+    {
+        freeCovariance(cov);
+        return -1;
+    }
+
+    cov->comoment = cov->mean + cols;
+
+    for(long index=0; index<cols+packed; index++)
+        cov->mean[index] = 0;
+
+    return 0;
+}
+
+/**
+ * @brief Fold the buffered rows into the co-moments as one block.
+ *
+ * The block is centred on its own mean and its co-moment matrix is a set of dot products
+ * between its contiguous columns; block and running totals are then combined with the
+ * pairwise update of Chan et al., like 'runningStatsMerge' does for a single column.
+ */
+static void covarianceFlush(dmlCovariance_t *cov)
+{
+    int rows = cov->blockRows;
+    int cols = cov->cols;
+    float *blockMean = cov->block + (long)DML_COV_BLOCK * cols;
+    long total = cov->count + rows;
+    dmlAccum_t share;
+
+    if(rows == 0)
+        return;
+
+    share = (dmlAccum_t)rows / (dmlAccum_t)total;
+
+    for(int col=0; col<cols; col++)
+    {
+        float *column = cov->block + (long)col * DML_COV_BLOCK;
+
+        blockMean[col] = sumBlock(column, rows) / (float)rows;
+        affineVectorInto(column, column, rows, 1, -blockMean[col]);
+    }
+
+    for(int i=0; i<cols; i++)
+    {
+        const float *columnI = cov->block + (long)i * DML_COV_BLOCK;
+        dmlAccum_t deltaI = (dmlAccum_t)blockMean[i] - cov->mean[i];
+        dmlAccum_t *target = cov->comoment + packedIndex(i, i, cols);
+
+        for(int j=i; j<cols; j++)
+        {
+            dmlAccum_t deltaJ = (dmlAccum_t)blockMean[j] - cov->mean[j];
+
+            target[j - i] += dotBlock(columnI, cov->block + (long)j * DML_COV_BLOCK, rows)
+                             + deltaI * deltaJ * (dmlAccum_t)cov->count * share;
+        }
+    }
+
+    for(int col=0; col<cols; col++)
+        cov->mean[col] += ((dmlAccum_t)blockMean[col] - cov->mean[col]) * share;
+
+    cov->count = total;
+    cov->blockRows = 0;
+}
+
+/**
+ * @brief Add one row of 'cov->cols' features to a covariance accumulator.
+ *
+ * @param cov A pointer to an initialised accumulator.
+ * @param row A pointer to the feature values of the row.
+ */
+void covarianceUpdate(dmlCovariance_t *cov, const float *row)
+{
+    for(int col=0; col<cov->cols; col++)
+        cov->block[(long)col * DML_COV_BLOCK + cov->blockRows] = row[col];
+
+    if(++cov->blockRows == DML_COV_BLOCK)
+        covarianceFlush(cov);
+}
+
+/**
+ * @brief Add 'numRows' contiguous row-major rows, e.g. a block from 'csvStreamReadRows'.
+ *
+ * @param cov     A pointer to an initialised accumulator.
+ * @param rows    A pointer to 'numRows * cov->cols' floats.
+ * @param numRows The number of rows.
+ */
+void covarianceUpdateRows(dmlCovariance_t *cov, const float *rows, int numRows)
+{
+    for(int row=0; row<numRows; row++)
+        covarianceUpdate(cov, rows + (long)row * cov->cols);
+}
+
+/**
+ * @brief Add rows [rowBegin, rowEnd) of a columnar view, copying column segments straight into the block.
+ */
+static void covarianceUpdateColumnar(dmlCovariance_t *cov, const dmlColumnar_t *view, int rowBegin, int rowEnd)
+{
+    for(int row=rowBegin; row<rowEnd; )
+    {
+        int count = DML_COV_BLOCK - cov->blockRows;
+
+        if(count > rowEnd - row)
+            count = rowEnd - row;
+
+        for(int col=0; col<cov->cols; col++)
+            memcpy(cov->block + (long)col * DML_COV_BLOCK + cov->blockRows, view->data + (long)col * view->stride + row, sizeof(float) * count);
+
+        cov->blockRows += count;
+        row += count;
+
+        if(cov->blockRows == DML_COV_BLOCK)
+            covarianceFlush(cov);
+    }
+}
+
+/**
+ * @brief Combine the accumulator 'other' into 'into'; both must have the same 'cols'.
+ *
+ * @param into  A pointer to the accumulator that receives the combined statistics.
+ * @param other A pointer to the accumulator to fold in. Its buffered rows are folded
+ *              into its own totals first, which does not change its results.
+ */
+void covarianceMerge(dmlCovariance_t *into, dmlCovariance_t *other)
+{
+    int cols = into->cols;
+    long total;
+    dmlAccum_t share;
+
+    covarianceFlush(into);
+    covarianceFlush(other);
+
+    if(other->count == 0)
+        return;
+
+    total = into->count + other->count;
+    share = (dmlAccum_t)other->count / (dmlAccum_t)total;
+
+    for(int i=0; i<cols; i++)
+    {
+        dmlAccum_t deltaI = other->mean[i] - into->mean[i];
+
+        for(int j=i; j<cols; j++)
+        {
+            long index = packedIndex(i, j, cols);
+
+            into->comoment[index] += other->comoment[index]
+                                     + deltaI * (other->mean[j] - into->mean[j]) * (dmlAccum_t)into->count * share;
+        }
+    }
+
+    for(int col=0; col<cols; col++)
+        into->mean[col] += (other->mean[col] - into->mean[col]) * share;
+
+    into->count = total;
+}
+
+/**
+ * @brief Write the population covariance matrix of everything added so far, in packed storage.
+ *
+ * @param cov A pointer to the accumulator; buffered rows are folded in first.
+ * @param out A pointer to cols * (cols + 1) / 2 floats, see 'packedIndex'.
+ */
+void covarianceFinalize(dmlCovariance_t *cov, float *out)
+{
+    long packed = (long)cov->cols * (cov->cols + 1) / 2;
+
+    covarianceFlush(cov);
+
+    for(long index=0; index<packed; index++)
+        out[index] = (cov->count > 0) ? (float)(cov->comoment[index] / (dmlAccum_t)cov->count) : 0;
+}
+
+/**
+ * @brief Write the Pearson correlation matrix of everything added so far, in packed storage.
+ *
+ * @param cov A pointer to the accumulator; buffered rows are folded in first.
+ * @param out A pointer to cols * (cols + 1) / 2 floats, see 'packedIndex'.
+ *
+ * @note Pairs involving a constant feature get a correlation of 0.
+ */
+void correlationFinalize(dmlCovariance_t *cov, float *out)
+{
+    int cols = cov->cols;
+
+    covarianceFlush(cov);
+
+    for(int i=0; i<cols; i++)
+    {
+        dmlAccum_t varI = cov->comoment[packedIndex(i, i, cols)];
+
+        for(int j=i; j<cols; j++)
+        {
+            dmlAccum_t norms = varI * cov->comoment[packedIndex(j, j, cols)];
+            long index = packedIndex(i, j, cols);
+
+            out[index] = (norms > 0) ? (float)(cov->comoment[index] / sqrt((double)norms)) : 0;
+        }
+    }
+}
+
+/**
+ * @brief Release the memory held by a covariance accumulator.
+ *
+ * @param cov A pointer to an accumulator set up by 'covarianceInit'.
+ */
+void freeCovariance(dmlCovariance_t *cov)
+{
+    dmlFree(cov->block);
+    dmlFree(cov->mean);
+    cov->block = NULL;
+    cov->mean = NULL;
+    cov->comoment = NULL;
+}
+
+/*
+ * A unit of work for the parallel statistics: feed rows [rowBegin, rowEnd) of columns
+ * [colBegin, colEnd) into 'stats', which is indexed by column, or, when 'covariance' is
+ * set, the whole rows into that accumulator.
+ */
+typedef struct statsTask
+{
+    csvData_t *df;
+    const dmlColumnar_t *view;
+    int rowBegin;
+    int rowEnd;
+    int colBegin;
+    int colEnd;
+    dmlRunningStats_t *stats;
+    dmlCovariance_t *covariance;
+} statsTask_t;
+
+static void runStatsTask(statsTask_t *task)
+{
+    if(task->covariance != NULL && task->view != NULL)
+    {
+        covarianceUpdateColumnar(task->covariance, task->view, task->rowBegin, task->rowEnd);
+        return;
+    }
+
+    if(task->covariance != NULL)
+    {
+        for(int row=task->rowBegin; row<task->rowEnd; row++)
+            covarianceUpdate(task->covariance, task->df->dataFrame[row]);
+        return;
+    }
+
+    if(task->view != NULL)
+    {
+        for(int col=task->colBegin; col<task->colEnd; col++)
+        {
+            const float *column = task->view->data + (long)col * task->view->stride;
+
+            for(int row=task->rowBegin; row<task->rowEnd; row++)
+                runningStatsUpdate(task->stats + col, column[row]);
+        }
+        return;
+    }
+
+    for(int row=task->rowBegin; row<task->rowEnd; row++)
+    {
+        const float *values = task->df->dataFrame[row];
+
+        for(int col=task->colBegin; col<task->colEnd; col++)
+            runningStatsUpdate(task->stats + col, values[col]);
+    }
+}
+
+#if defined(DML_THREADS_PTHREAD)
+static void *statsTaskThread(void *arg)
+{
+    runStatsTask((statsTask_t *)arg);
+    return NULL;
+}
+#endif
+
+/**
+ * @brief Run 'numTasks' independent statistics tasks on the compiled-in threading backend.
+ */
+static void runStatsTasks(statsTask_t *tasks, int numTasks)
+{
+#if defined(DML_THREADS_OPENMP)
+    #pragma omp parallel for schedule(static)
+    for(int task=0; task<numTasks; task++)
+        runStatsTask(tasks + task);
+#elif defined(DML_THREADS_PTHREAD)
+    pthread_t *threads = (pthread_t *)dmlAlloc(sizeof(pthread_t) * numTasks);
+    char *started = (char *)dmlAlloc((size_t)numTasks);
+
+    if(started != NULL)
+        memset(started, 0, (size_t)numTasks);
+
+    for(int task=1; task<numTasks; task++)
+    {
+        if(threads != NULL && started != NULL && pthread_create(threads + task, NULL, statsTaskThread, tasks + task) == 0)
+            started[task] = 1;
+        else
+            runStatsTask(tasks + task);
+    }
+
+    runStatsTask(tasks);
+
+    for(int task=1; task<numTasks; task++)
+    {
+        if(started != NULL && started[task])
+            pthread_join(threads[task], NULL);
+    }
+
+    dmlFree(started);
+    dmlFree(threads);
+#else
+    for(int task=0; task<numTasks; task++)
+        runStatsTask(tasks + task);
+#endif
+}
+
+/**
+ * @brief Number of worker threads used when the caller asks for the default (0).
+ */
+static int defaultThreadCount(void)
+{
+#if defined(DML_THREADS_OPENMP)
+    return omp_get_max_threads();
+#elif defined(DML_THREADS_PTHREAD)
+    return DML_DEFAULT_THREADS;
+#else
+    return 1;
+#endif
+}
+
+/**
+ * @brief Calculate the 'columnStats' of every column of a '.csv' file, optionally in parallel.
+ *
+ * Work is split across up to 'numThreads' threads. A frame with an attached columnar
+ * view is partitioned by column, since each column is then contiguous; otherwise the
+ * rows are cut into one block per thread, every block accumulates all columns into its
+ * own running statistics, and the partial results are merged with 'runningStatsMerge'.
+ * The threading backend is chosen at compile time: OpenMP when built with OpenMP
+ * enabled, POSIX threads when DML_USE_PTHREADS is defined, and a serial loop otherwise,
+ * which is what embedded builds get.
+ *
+ * @param df         A pointer to the '.csv' file data structure.
+ * @param out        A pointer to 'df->cols' structures receiving the statistics.
+ * @param numThreads The maximum number of threads to use; 0 selects the backend default.
+ *
+ * @return 0 on success, -1 if the working memory could not be allocated.
+ *
+ * @note Merging row blocks happens in block order, so the result for a given thread
+ *       count is deterministic.
+ *
+ * @code
+ *   // Example usage:
+ *   dmlStats_t *stats = (dmlStats_t *)malloc(sizeof(dmlStats_t) * data.cols);
+ *   columnStatsAll(&data, stats, 0);
+ *   // stats[col].mean, stats[col].stdDev, ...
+ *   free(stats);
+ * @endcode
+ */
+int columnStatsAll(csvData_t *df, dmlStats_t *out, int numThreads)
+{
+    DML_PROFILE_BEGIN(DML_PROF_COLUMN_STATS_ALL, (long)df->rows * df->cols);
+
+    const dmlColumnar_t *view = findColumnar(df);
+    int byColumn = (view != NULL);
+    int limit = byColumn ? df->cols : df->rows;
+    int numTasks = (numThreads > 0) ? numThreads : defaultThreadCount();
+    int numStats;
+    statsTask_t *tasks;
+    dmlRunningStats_t *stats;
+
+    if(numTasks > limit)
+        numTasks = limit;
+    if(numTasks < 1)
+        numTasks = 1;
+
+    numStats = df->cols * (byColumn ? 1 : numTasks);
+    tasks = (statsTask_t *)dmlAlloc(sizeof(statsTask_t) * numTasks);
+    stats = (dmlRunningStats_t *)dmlAlloc(sizeof(dmlRunningStats_t) * (numStats > 0 ? numStats : 1));
+
+    if(tasks == NULL || stats == NULL)
+    {
+        dmlFree(stats);
+        dmlFree(tasks);
+        DML_PROFILE_END();
+        return -1;
+    }
+
+    for(int index=0; index<numStats; index++)
+        runningStatsInit(stats + index);
+
+    for(int task=0; task<numTasks; task++)
+    {
+        long begin = (long)limit * task / numTasks;
+        long end = (long)limit * (task + 1) / numTasks;
+
+        tasks[task].df = df;
+        tasks[task].view = view;
+        tasks[task].rowBegin = byColumn ? 0 : (int)begin;
+        tasks[task].rowEnd = byColumn ? df->rows : (int)end;
+        tasks[task].colBegin = byColumn ? (int)begin : 0;
+        tasks[task].colEnd = byColumn ? (int)end : df->cols;
+        tasks[task].stats = byColumn ? stats : stats + (long)task * df->cols;
+        tasks[task].covariance = NULL;
+    }
+
+    runStatsTasks(tasks, numTasks);
+
+    for(int task=1; task<numTasks && !byColumn; task++)
+    {
+        for(int col=0; col<df->cols; col++)
+            runningStatsMerge(stats + col, stats + (long)task * df->cols + col);
+    }
+
+    for(int col=0; col<df->cols; col++)
+        runningStatsFinalize(stats + col, out + col);
+
+    dmlFree(stats);
+    dmlFree(tasks);
+
+    DML_PROFILE_END();
+    return 0;
+}
+
+/**
+ * @brief Accumulate the covariance of every pair of columns in one blocked, optional parallel pass.
+ */
+static int accumulateCovariance(csvData_t *df, int numThreads, dmlCovariance_t *result)
+{
+    int numTasks = (numThreads > 0) ? numThreads : defaultThreadCount();
+    statsTask_t *tasks;
+    dmlCovariance_t *partial;
+    int ready = 0;
+
+    if(numTasks > df->rows / DML_COV_BLOCK)
+        numTasks = df->rows / DML_COV_BLOCK;
+    if(numTasks < 1)
+        numTasks = 1;
+
+    // The result is allocated first and every temporary is released in reverse order, so
+    // under DML_NO_HEAP only the result is left on the arena when this returns.
+    if(covarianceInit(result, df->cols) != 0)
+        return -1;
+
+    tasks = (statsTask_t *)dmlAlloc(sizeof(statsTask_t) * numTasks);
+    partial = (dmlCovariance_t *)dmlAlloc(sizeof(dmlCovariance_t) * numTasks);
+
+    if(tasks != NULL && partial != NULL)
+    {
+        while(ready < numTasks && covarianceInit(partial + ready, df->cols) == 0)
+            ready++;
+    }
+
+    if(ready == numTasks)
+    {
+        for(int task=0; task<numTasks; task++)
+        {
+            tasks[task].df = df;
+            tasks[task].view = findColumnar(df);
+            tasks[task].rowBegin = (int)((long)df->rows * task / numTasks);
+            tasks[task].rowEnd = (int)((long)df->rows * (task + 1) / numTasks);
+            tasks[task].colBegin = 0;
+            tasks[task].colEnd = df->cols;
+            tasks[task].stats = NULL;
+            tasks[task].covariance = partial + task;
+        }
+
+        runStatsTasks(tasks, numTasks);
+
+        for(int task=0; task<numTasks; task++)
+            covarianceMerge(result, partial + task);
+    }
+
+    for(int task=ready-1; task>=0; task--)
+        freeCovariance(partial + task);
+
+    dmlFree(partial);
+    dmlFree(tasks);
+
+    if(ready != numTasks)
+    {
+        freeCovariance(result);
+        return -1;
+    }
+
+    return 0;
+}
+
+/**
+ * @brief Calculate the population covariance of every pair of columns of a '.csv' file.
+ *
+ * All pairs come from a single pass over the rows: every DML_COV_BLOCK rows are transposed
+ * into a cache-resident block, centred, and multiplied with themselves (see
+ * 'dmlCovariance_t'). With more than one thread the rows are split into one range per
+ * thread and the partial results are merged in order, so the result is deterministic.
+ *
+ * @param df         A pointer to the '.csv' file data structure.
+ * @param out        A pointer to df->cols * (df->cols + 1) / 2 floats receiving the upper
+ *                   triangle of the matrix, see 'packedIndex'.
+ * @param numThreads The maximum number of threads to use; 0 selects the backend default.
+ *
+ * @return 0 on success, -1 if the working memory could not be allocated.
+ *
+ * @code
+ *   // Example usage:
+ *   float *cov = createFloatVector(data.cols * (data.cols + 1) / 2);
+ *   covarianceMatrix(&data, cov, 0);
+ *   float cov23 = cov[packedIndex(2, 3, data.cols)];
+ * @endcode
+ */
+int covarianceMatrix(csvData_t *df, float *out, int numThreads)
+{
+    DML_PROFILE_BEGIN(DML_PROF_COVARIANCE_MATRIX, (long)df->rows * df->cols);
+
+    dmlCovariance_t cov;
+
+    if(accumulateCovariance(df, numThreads, &cov) != 0)
+    {
+        DML_PROFILE_END();
+        return -1;
+    }
+
+    covarianceFinalize(&cov, out);
+    freeCovariance(&cov);
+
+    DML_PROFILE_END();
+    return 0;
+}
+
+/**
+ * @brief Calculate the Pearson correlation of every pair of columns of a '.csv' file.
+ *
+ * This works like 'covarianceMatrix' and normalises the result by the standard deviations.
+ *
+ * @param df         A pointer to the '.csv' file data structure.
+ * @param out        A pointer to df->cols * (df->cols + 1) / 2 floats, see 'packedIndex'.
+ * @param numThreads The maximum number of threads to use; 0 selects the backend default.
+ *
+ * @return 0 on success, -1 if the working memory could not be allocated.
+ */
+int correlationMatrix(csvData_t *df, float *out, int numThreads)
+{
+    DML_PROFILE_BEGIN(DML_PROF_CORRELATION_MATRIX, (long)df->rows * df->cols);
+
+    dmlCovariance_t cov;
+
+    if(accumulateCovariance(df, numThreads, &cov) != 0)
+    {
+        DML_PROFILE_END();
+        return -1;
+    }
+
+    correlationFinalize(&cov, out);
+    freeCovariance(&cov);
+
+    DML_PROFILE_END();
+    return 0;
+}
+
+/**
+ * @brief Summarise every column of a '.csv' file, in the manner of pandas' 'describe()'.
+ *
+ * This function fills one 'dmlSummary_t' per column with the count, mean, standard
+ * deviation, minimum, quartiles and maximum. The moments of all columns come from one
+ * fused pass ('columnStatsAll'), and the quartiles of each column from one selection over
+ * a single scratch buffer that is shared by all columns.
+ *
+ * @param df  A pointer to the '.csv' file data structure.
+ * @param out A pointer to 'df->cols' summaries to fill.
+ *
+ * @return 0 on success, -1 if the working memory could not be allocated.
+ *
+ * @code
+ *   // Example usage:
+ *   csvData_t data = loadCsv(FILE); // Assuming the file has been loaded successfully.
+ *   dmlSummary_t *summary = (dmlSummary_t *)malloc(sizeof(dmlSummary_t) * data.cols);
+ *   describe(&data, summary);
+ *   printSummary(summary, data.cols);
+ *   free(summary);
+ * @endcode
+ */
+int describe(csvData_t *df, dmlSummary_t *out)
+{
+    DML_PROFILE_BEGIN(DML_PROF_DESCRIBE, (long)df->rows * df->cols);
+
+    dmlStats_t *stats = (dmlStats_t *)dmlAlloc(sizeof(dmlStats_t) * (df->cols > 0 ? df->cols : 1));
+    float *feature = createFloatVector(df->rows > 0 ? df->rows : 1);
+
+    if(stats == NULL || feature == NULL || columnStatsAll(df, stats, 0) != 0)
+    {
+        dmlFree(feature);
+        dmlFree(stats);
+        DML_PROFILE_END();
+        return -1;
+    }
+
+    for(int col=0; col<df->cols; col++)
+    {
+        gatherColumn(df, col, feature);
+        quartilesOfVector(feature, df->rows, &out[col].q25, &out[col].median, &out[col].q75);
+
+        out[col].count = stats[col].count;
+        out[col].mean = stats[col].mean;
+        out[col].stdDev = stats[col].stdDev;
+        out[col].min = stats[col].min;
+        out[col].max = stats[col].max;
+    }
+
+    dmlFree(feature);
+    dmlFree(stats);
+
+    DML_PROFILE_END();
+    return 0;
+}
+
+/**
+ * @brief Display the summaries produced by 'describe' as a table.
+ *
+ * Each line shows one statistic, each column one feature, in the same layout as 'head'.
+ *
+ * @param summary A pointer to 'cols' summaries filled by 'describe'.
+ * @param cols    The number of summaries.
+ */
+void printSummary(const dmlSummary_t *summary, int cols)
+{
+    static const char *labels[] = {"count", "mean", "std", "min", "25%", "50%", "75%", "max"};
+
+    printf("*** ================ SUMMARY ================ ***\n");
+    for(int line=0; line<8; line++)
+    {
+        printf("%-6s", labels[line]);
+        for(int col=0; col<cols; col++)
+        {
+            const dmlSummary_t *s = summary + col;
+            float values[] = {(float)s->count, s->mean, s->stdDev, s->min, s->q25, s->median, s->q75, s->max};
+
+            printf("%10.3f\t", values[line]);
+        }
+        puts(" ");
+    }
+    printf("*** ========================================= ***\n");
+}
+
+/**
+ * @brief Copy the counters of every instrumented function into 'out'.
+ *
+ * @param out        A pointer to at least 'maxEntries' entries to fill.
+ * @param maxEntries The capacity of 'out'.
+ *
+ * @return The number of entries written; always 0 unless built with DML_PROFILE.
+ *
+ * @note The counters are plain globals: calls made from several threads at the same time
+ *       may be miscounted, calls from the library's own worker threads are not instrumented.
+ */
+int profileSnapshot(dmlProfileEntry_t *out, int maxEntries)
+{
+#if defined(DML_PROFILE)
+    int count = (maxEntries < DML_PROF_COUNT) ? maxEntries : DML_PROF_COUNT;
+
+    for(int entry=0; entry<count; entry++)
+        out[entry] = profileTable[entry];
+
+    return count;
+#else
+    (void)out;
+    (void)maxEntries;
+    return 0;
+#endif
+}
+
+/**
+ * @brief Zero the counters of every instrumented function.
+ */
+void profileReset(void)
+{
+#if defined(DML_PROFILE)
+    for(int entry=0; entry<DML_PROF_COUNT; entry++)
+    {
+        profileTable[entry].calls = 0;
+        profileTable[entry].elements = 0;
+        profileTable[entry].bytes = 0;
+        profileTable[entry].ticks = 0;
+    }
+#endif
+}
+
+/**
+ * @brief Unit of 'dmlProfileEntry_t.ticks': "cycles" on Cortex-M, "ns" elsewhere.
+ */
+const char *profileTickUnit(void)
+{
+#if defined(DML_PROFILE_DWT)
+    return "cycles";
+#else
+    return "ns";
+#endif
+}
+
+/** @brief Append 'value' to a buffered writer, right-aligned in a field of 'width' characters. */
+static void writerPutCount(dmlWriter_t *writer, uint64_t value, int width)
+{
+    char text[24];
+    int len = 0;
+
+    do
+    {
+        text[sizeof(text) - 1 - len++] = (char)('0' + value % 10);
+        value /= 10;
+    } while(value > 0);
+
+    for(; width>len; width--)
+        writerPut(writer, " ", 1);
+
+    writerPut(writer, text + sizeof(text) - len, len);
+}
+
+/**
+ * @brief Write the counters of every function called so far as a table, like 'headTo'.
+ *
+ * One line per instrumented function that has been called, with its calls, elements,
+ * bytes allocated, ticks and ticks per element.
+ *
+ * @param writer A pointer to an initialised writer.
+ *
+ * @note The text is only buffered; call 'writerFlush' once the output is complete.
+ */
+void profileTo(dmlWriter_t *writer)
+{
+    static const char banner[] = "*** ================ PROFILE ================ ***\n";
+    static const char footer[] = "*** ========================================= ***\n";
+    static const char columns[] = "function                 calls     elements        bytes        ticks  ticks/elem\n";
+    dmlProfileEntry_t entries[DML_MAX_PROFILE_ENTRIES];
+    int count = profileSnapshot(entries, DML_MAX_PROFILE_ENTRIES);
+
+    writerPut(writer, banner, (int)sizeof(banner) - 1);
+    writerPut(writer, columns, (int)sizeof(columns) - 1);
+
+    for(int entry=0; entry<count; entry++)
+    {
+        const dmlProfileEntry_t *e = entries + entry;
+        int nameLen = (int)strlen(e->name);
+
+        if(e->calls == 0)
+            continue;
+
+        writerPut(writer, e->name, nameLen);
+        for(; nameLen<20; nameLen++)
+            writerPut(writer, " ", 1);
+        writerPutCount(writer, e->calls, 10);
+        writerPutCount(writer, e->elements, 13);
+        writerPutCount(writer, e->bytes, 13);
+        writerPutCount(writer, e->ticks, 13);
+        writerPutFloat(writer, e->elements > 0 ? (float)((double)e->ticks / (double)e->elements) : 0, 12, 3);
+        writerPut(writer, "\n", 1);
+    }
+
+    writerPut(writer, footer, (int)sizeof(footer) - 1);
+}
+
+/**
+ * @brief Print the profile table of 'profileTo' to stdout.
+ *
+ * @code
+ *   // Example usage (build the library with -DDML_PROFILE):
+ *   profileReset();
+ *   float m = median(&data, 2);
+ *   printProfile();
+ * @endcode
+ */
+void printProfile(void)
+{
+    char text[128];
+    dmlWriter_t writer;
+
+    writerInit(&writer, writeToFile, stdout, text, (int)sizeof(text));
+    profileTo(&writer);
+    writerFlush(&writer);
 }
@@ -25,18 +25,731 @@
 #ifndef DML_DML_H
 #define DML_DML_H
 
+#include <stddef.h>
+#include <stdint.h>
 #include "../open_csv/open_csv.h"
 
+/* Alignment of the blocks handed out by a 'dmlArena_t'. */
+#ifndef DML_ARENA_ALIGN
+#define DML_ARENA_ALIGN 8
+#endif
+
+/*
+ * Size of the static arena that backs all allocations when DML_NO_HEAP is defined.
+ *
+ * Temporaries are released before a call returns, so the arena must hold what the caller
+ * keeps alive plus the largest single call. Each block also costs a header of two
+ * 'size_t' and up to DML_ARENA_ALIGN bytes of padding. The temporaries are about:
+ *   median, quantile              4 * rows
+ *   describe                      4 * rows + (sizeof(dmlStats_t) + sizeof(dmlRunningStats_t)) * cols
+ *   medianAll, quantileMatrix     4 * rows * min(ncols, DML_GATHER_COLS)
+ *   covariance / correlation      sizeof(dmlAccum_t) * cols * (cols + 3) / 2 + 4 * (DML_COV_BLOCK + 1) * cols
+ *   toColumnar, pairwiseDistances 4 * rows * cols, and 4 * (a->rows + b->rows)
+ * The 1024-byte default therefore limits column temporaries to roughly 250 rows. Calls
+ * that do not fit fail cleanly, returning NULL, -1 or NaN as documented.
+ */
+#ifndef DML_STATIC_HEAP_SIZE
+#define DML_STATIC_HEAP_SIZE 1024
+#endif
+
+/*
+ * Accumulator of sums, means and variances. Frame elements are always 'float' (they come
+ * from "open_csv.h"), but their statistics are accumulated in 'dmlAccum_t': 'double' on
+ * hosts for accuracy over long columns, 'float' on Cortex-M where double precision is
+ * emulated in software. Define DML_ACCUMULATOR to override either choice.
+ */
+#ifndef DML_ACCUMULATOR
+#if defined(__ARM_ARCH_PROFILE) && (__ARM_ARCH_PROFILE == 'M')
+#define DML_ACCUMULATOR float
+#else
+#define DML_ACCUMULATOR double
+#endif
+#endif
+
+typedef DML_ACCUMULATOR dmlAccum_t;
+
+/* Summation algorithms selectable through DML_SUMMATION. */
+#define DML_SUM_NAIVE    0
+#define DML_SUM_KAHAN    1
+#define DML_SUM_PAIRWISE 2
+
+/*
+ * Summation used by 'sumVector', 'sumOfSquaresVector' and 'mean'. Values are first summed in
+ * blocks of DML_SUM_BLOCK elements (with the SIMD kernels where available); the block sums are
+ * then added in 'dmlAccum_t' sequentially (naive), with Kahan compensation, or pairwise, which
+ * bounds the rounding error by O(log n) instead of O(n).
+ */
+#ifndef DML_SUMMATION
+#define DML_SUMMATION DML_SUM_PAIRWISE
+#endif
+
+#ifndef DML_SUM_BLOCK
+#define DML_SUM_BLOCK 128
+#endif
+
+/**
+ * @brief Allocation interface used by every allocating function of the library.
+ *
+ * 'alloc' returns a block of at least 'size' bytes or NULL, 'release' gives a block back;
+ * both receive 'context' unchanged. Install one with 'setAllocator'.
+ */
+typedef struct dmlAllocator
+{
+    void *(*alloc)(void *context, size_t size);
+    void (*release)(void *context, void *block);
+    void *context;
+} dmlAllocator_t;
+
+/**
+ * @brief Bump allocator over a fixed buffer, with O(1) mark/reset.
+ *
+ * Set up with 'arenaInit'; install it for the library with 'useArena'.
+ */
+typedef struct dmlArena
+{
+    unsigned char *base;
+    size_t capacity;
+    size_t used;
+} dmlArena_t;
+
+/**
+ * @brief Summary statistics of a single column, filled by 'columnStats'.
+ *
+ * 'variance' and 'stdDev' are population statistics, i.e. normalised by 'count'.
+ */
+typedef struct dmlStats
+{
+    int count;
+    float mean;
+    float variance;
+    float stdDev;
+    float min;
+    float max;
+} dmlStats_t;
+
+/**
+ * @brief Per-column summary filled by 'describe', in the manner of pandas' 'describe()'.
+ *
+ * 'stdDev' is the population standard deviation; the quartiles interpolate linearly
+ * between ranks, like 'quantile'.
+ */
+typedef struct dmlSummary
+{
+    int count;
+    float mean;
+    float stdDev;
+    float min;
+    float q25;
+    float median;
+    float q75;
+    float max;
+} dmlSummary_t;
+
+/**
+ * @brief Online accumulator of count, mean, variance, minimum and maximum.
+ *
+ * Feed it one value at a time with 'runningStatsUpdate', combine partial accumulators with
+ * 'runningStatsMerge' and read the results with 'runningStatsFinalize'. 'm2' is the running
+ * sum of squared differences from the mean (Welford); no history of values is kept. The mean
+ * and 'm2' are kept in 'dmlAccum_t'.
+ */
+typedef struct dmlRunningStats
+{
+    long count;
+    dmlAccum_t mean;
+    dmlAccum_t m2;
+    float min;
+    float max;
+} dmlRunningStats_t;
+
+/* Longest '.csv' field, including the terminator, that 'csvStreamReadRows' parses in full. */
+#ifndef DML_CSV_FIELD_MAX
+#define DML_CSV_FIELD_MAX 32
+#endif
+
+/**
+ * @brief Source of '.csv' text for a 'dmlCsvStream_t'.
+ *
+ * Fills 'buffer' with at most 'size' bytes and returns how many were written, or 0 at
+ * the end of the input. 'csvReadFile' implements it for stdio files.
+ */
+typedef size_t (*dmlReadFn)(void *context, char *buffer, size_t size);
+
+/**
+ * @brief Incremental '.csv' reader working from a fixed caller-provided chunk buffer.
+ *
+ * Set up with 'csvStreamInit'; the fields are internal to the reader.
+ */
+typedef struct dmlCsvStream
+{
+    dmlReadFn read;
+    void *context;
+    char *buffer;
+    int bufferSize;
+    int bufferLen;
+    int bufferPos;
+    int skipLine;
+    int eof;
+} dmlCsvStream_t;
+
+/* Most row blocks the loader pipeline's ring can hold. */
+#ifndef DML_PIPELINE_MAX_BLOCKS
+#define DML_PIPELINE_MAX_BLOCKS 8
+#endif
+
+/**
+ * @brief Producer of the loader pipeline: store up to 'maxRows' rows of 'cols' floats in 'block'.
+ *
+ * Returns the number of rows stored, 0 at the end of the input or a negative value on
+ * error. A '.csv' stream, the binary format or a DMA transfer can sit behind it.
+ */
+typedef int (*dmlBlockReadFn)(void *context, float *block, int maxRows, int cols);
+
+/**
+ * @brief Consumer of the loader pipeline: process 'rows' rows of 'cols' floats in 'block'.
+ *
+ * The block is only valid during the call; it is refilled once the consumer returns.
+ */
+typedef void (*dmlBlockFn)(void *context, const float *block, int rows, int cols);
+
+/* Threads 'columnStatsAll' starts by default with the POSIX threads backend. */
+#ifndef DML_DEFAULT_THREADS
+#define DML_DEFAULT_THREADS 4
+#endif
+
+/* Bytes 'formatFloat' may write for one value. */
+#define DML_FLOAT_TEXT_MAX 24
+
+/**
+ * @brief Sink for the text produced by a 'dmlWriter_t', e.g. a UART driver.
+ *
+ * 'writeToFile' implements it for stdio files.
+ */
+typedef void (*dmlWriteFn)(void *context, const char *text, size_t len);
+
+/**
+ * @brief Buffered text writer over a fixed caller-provided buffer.
+ *
+ * Set up with 'writerInit'; the fields are internal to the writer.
+ */
+typedef struct dmlWriter
+{
+    dmlWriteFn write;
+    void *context;
+    char *buffer;
+    int bufferSize;
+    int used;
+} dmlWriter_t;
+
+/*
+ * Floats each column of a 'dmlColumnar_t' is padded to, so every column starts on a
+ * 16-byte boundary whenever the block itself does.
+ */
+#ifndef DML_COLUMNAR_ALIGN
+#define DML_COLUMNAR_ALIGN 4
+#endif
+
+/* Columns that 'medianAll' and 'quantileMatrix' transpose into their scratch buffer per pass. */
+#ifndef DML_GATHER_COLS
+#define DML_GATHER_COLS 8
+#endif
+
+/* Number of frames that can have a columnar view attached at the same time. */
+#ifndef DML_MAX_COLUMNAR_VIEWS
+#define DML_MAX_COLUMNAR_VIEWS 4
+#endif
+
+/**
+ * @brief Column-major copy of a data frame held in one contiguous block.
+ *
+ * Column 'col' occupies 'rows' consecutive floats starting at 'data + col * stride'.
+ * Create it with 'toColumnar' and release it with 'freeColumnar'.
+ */
+typedef struct dmlColumnar
+{
+    float *data;
+    int rows;
+    int cols;
+    int stride;
+} dmlColumnar_t;
+
+/**
+ * @brief Non-owning view of 'len' floats that need not be contiguous.
+ *
+ * Element 'i' is 'base[i * stride]' when 'rows' is NULL, and 'rows[i][col]' otherwise,
+ * which is how a column of 'csvData_t' is reached without copying it. Make one with
+ * 'vectorView', 'stridedView' or 'columnView'; the view never owns the data. 'frame' is
+ * the frame a 'columnView' came from (NULL otherwise), so writes through the view can
+ * invalidate that frame's statistics cache.
+ */
+typedef struct dmlVectorView
+{
+    float *base;
+    float **rows;
+    int col;
+    int len;
+    long stride;
+    csvData_t *frame;
+} dmlVectorView_t;
+
+/* Number of frames that can have a statistics cache attached at the same time. */
+#ifndef DML_MAX_STATS_CACHES
+#define DML_MAX_STATS_CACHES 4
+#endif
+
+/**
+ * @brief Memoized per-column statistics and sorted columns of one frame.
+ *
+ * Filled lazily while attached to a frame with 'attachStatsCache'; the fields are internal.
+ */
+typedef struct dmlStatsCache
+{
+    int rows;
+    int cols;
+    dmlStats_t *stats;
+    float **sorted;
+    unsigned char *valid;
+} dmlStatsCache_t;
+
+/**
+ * @brief Distance metrics of 'distancesToRows' and 'pairwiseDistances'.
+ *
+ * DML_DIST_L2SQ is the squared Euclidean distance, which ranks neighbours exactly like
+ * DML_DIST_L2 without the square roots.
+ */
+typedef enum dmlMetric
+{
+    DML_DIST_L2,
+    DML_DIST_L2SQ,
+    DML_DIST_L1,
+    DML_DIST_COSINE
+} dmlMetric;
+
+/* Largest 'k' for which 'topK' keeps a bounded heap on the stack instead of selecting. */
+#ifndef DML_TOPK_HEAP_MAX
+#define DML_TOPK_HEAP_MAX 32
+#endif
+
+/* Rows per side of the tiles 'pairwiseDistances' works on. */
+#ifndef DML_DIST_BLOCK
+#define DML_DIST_BLOCK 32
+#endif
+
+/**
+ * @brief Column normalisation performed by 'normalizeFrame'.
+ */
+typedef enum dmlNormMode
+{
+    DML_NORM_MINMAX,
+    DML_NORM_ZSCORE
+} dmlNormMode;
+
+/**
+ * @brief Per-column normalisation fitted by 'normalizeFrame'.
+ *
+ * Every column is transformed as 'x * scale[col] + offset[col]', so the parameters can be
+ * reapplied to new samples with 'applyNormalizationRow'.
+ */
+typedef struct dmlNormParams
+{
+    dmlNormMode mode;
+    int cols;
+    float *scale;
+    float *offset;
+} dmlNormParams_t;
+
+/*
+ * Number of features fixed at build time, e.g. '-DDML_FIXED_COLS=4'. When it is above 0
+ * the 'fixed*' kernels below are compiled with constant, fully unrolled column loops.
+ */
+#ifndef DML_FIXED_COLS
+#define DML_FIXED_COLS 0
+#endif
+
+#if DML_FIXED_COLS > 0
+/* One sample of DML_FIXED_COLS features. */
+typedef float dmlFixedRow_t[DML_FIXED_COLS];
+
+/**
+ * @brief Read-only row-major frame of DML_FIXED_COLS columns, without row pointers.
+ *
+ * 'data' can point at a 'static const dmlFixedRow_t' table, so on microcontrollers the
+ * whole dataset stays in flash.
+ */
+typedef struct dmlFixedFrame
+{
+    const dmlFixedRow_t *data;
+    int rows;
+} dmlFixedFrame_t;
+
+/**
+ * @brief Normalisation of DML_FIXED_COLS columns stored inline, e.g. as a constant table.
+ *
+ * Fill it from fitted parameters with 'fixedNormFromParams' or initialise it statically.
+ */
+typedef struct dmlFixedNorm
+{
+    float scale[DML_FIXED_COLS];
+    float offset[DML_FIXED_COLS];
+} dmlFixedNorm_t;
+#endif
+
+/**
+ * @brief State of a xoshiro128** pseudo-random number generator.
+ *
+ * Seed it with 'rngSeed'. Each generator is independent, so giving every thread its own
+ * state makes sampling thread-safe and reproducible.
+ */
+typedef struct dmlRng
+{
+    uint32_t state[4];
+} dmlRng_t;
+
+/**
+ * @brief Reservoir sampler over a stream of rows of unknown length.
+ *
+ * Initialise it with 'reservoirInit' and call 'reservoirOffer' once per streamed row.
+ * 'indices[0 .. filled-1]' then hold the stream positions of the sampled rows.
+ */
+typedef struct dmlReservoir
+{
+    int *indices;
+    int capacity;
+    int filled;
+    long seen;
+} dmlReservoir_t;
+
+/**
+ * @brief One mini-batch produced by 'batchIterNext'.
+ *
+ * 'data' holds 'rows' x 'cols' floats in row-major order; 'indices[i]' is the frame row
+ * that row 'i' of the batch was copied from.
+ */
+typedef struct dmlBatch
+{
+    float *data;
+    int rows;
+    int cols;
+    const int *indices;
+} dmlBatch_t;
+
+/**
+ * @brief Mini-batch iterator over the rows of a data frame.
+ *
+ * Set up with 'batchIterInit'; the fields are internal to the iterator.
+ */
+typedef struct dmlBatchIter
+{
+    csvData_t *df;
+    int batchSize;
+    float *buffer;
+    int shuffle;
+    dmlRng_t *rng;
+    int *order;
+    int position;
+    int epoch;
+} dmlBatchIter_t;
+
+/**
+ * @brief A binary dataset opened with 'mapBinaryFrame'.
+ *
+ * 'view' points straight into the mapped file, so it can be used wherever a
+ * 'dmlColumnar_t' is accepted without copying. 'binaryFrameAsCsv' wraps it in a frame for
+ * the 'csvData_t' functions; only 'pairwiseDistances' and 'sliceFrame' cannot use such a
+ * frame, as they need row pointers. 'stats' points to the per-column statistics stored in
+ * the file, or is NULL if the file was written without them.
+ */
+typedef struct dmlBinaryFrame
+{
+    dmlColumnar_t view;
+    const dmlStats_t *stats;
+    void *base;
+    size_t length;
+    int mapped;
+} dmlBinaryFrame_t;
+
+/**
+ * @brief Storage type of a 'dmlQuantColumn_t'.
+ */
+typedef enum dmlQuantType
+{
+    DML_QUANT_INT8,
+    DML_QUANT_INT16
+} dmlQuantType;
+
+/**
+ * @brief A column stored as 8- or 16-bit integers with an affine scale and zero point.
+ *
+ * Stored value 'q' represents the real value 'scale * (q - zeroPoint)'. 'data' points to
+ * 'rows' elements of type int8_t or int16_t depending on 'type'. Create it with
+ * 'quantizeColumn' and release it with 'freeQuantColumn'.
+ */
+typedef struct dmlQuantColumn
+{
+    dmlQuantType type;
+    int rows;
+    float scale;
+    int32_t zeroPoint;
+    void *data;
+} dmlQuantColumn_t;
+
+/**
+ * @brief Statistics of a quantized column in stored (integer) units, see 'quantColumnStats'.
+ *
+ * 'mean' is rounded to the nearest stored unit and 'variance' is the population variance
+ * in squared stored units, rounded down.
+ */
+typedef struct dmlQuantStats
+{
+    int count;
+    int32_t mean;
+    uint32_t variance;
+    int32_t min;
+    int32_t max;
+} dmlQuantStats_t;
+
+/*
+ * Number of markers kept by a 'dmlQuantileSketch_t'. The markers track the quantiles
+ * 0, 1/(N-1), ..., 1, so an odd count keeps the median as an exact marker. The sketch
+ * footprint is fixed at compile time to sizeof(dmlQuantileSketch_t), i.e. roughly
+ * 8 * DML_SKETCH_MARKERS + 8 bytes, no matter how many values are pushed.
+ */
+#ifndef DML_SKETCH_MARKERS
+#define DML_SKETCH_MARKERS 9
+#endif
+
+#if DML_SKETCH_MARKERS < 5
+#error "DML_SKETCH_MARKERS must be at least 5"
+#endif
+
+/**
+ * @brief Fixed-memory streaming quantile estimator (P-square algorithm, histogram variant).
+ *
+ * Fill it with 'quantileSketchPush' and read any quantile back with 'quantileSketchQuery'.
+ * The fields are internal to the algorithm and should not be modified by the caller.
+ */
+typedef struct dmlQuantileSketch
+{
+    long count;
+    float heights[DML_SKETCH_MARKERS];
+    long positions[DML_SKETCH_MARKERS];
+} dmlQuantileSketch_t;
+
+/* Capacity of the snapshot 'profileTo' formats; at least the number of instrumented functions. */
+#ifndef DML_MAX_PROFILE_ENTRIES
+#define DML_MAX_PROFILE_ENTRIES 32
+#endif
+
+/**
+ * @brief Counters of one instrumented library function, see 'profileSnapshot'.
+ *
+ * Only collected when the library is built with DML_PROFILE defined; otherwise the
+ * instrumentation compiles to nothing and 'profileSnapshot' reports no entries. 'ticks'
+ * are DWT cycles on Cortex-M and nanoseconds on hosts (see 'profileTickUnit') and include
+ * the time spent in nested library calls; 'bytes' counts what the function itself allocated.
+ */
+typedef struct dmlProfileEntry
+{
+    const char *name;
+    unsigned long calls;
+    uint64_t elements;
+    uint64_t bytes;
+    uint64_t ticks;
+} dmlProfileEntry_t;
+
+/* Rows a 'dmlCovariance_t' buffers before folding them into its co-moments as one block. */
+#ifndef DML_COV_BLOCK
+#define DML_COV_BLOCK 64
+#endif
+
+/**
+ * @brief Streaming accumulator of the means and co-moments of 'cols' features.
+ *
+ * Set up with 'covarianceInit', feed rows with 'covarianceUpdate' or 'covarianceUpdateRows',
+ * combine partial accumulators with 'covarianceMerge' and read the covariance or correlation
+ * matrix with 'covarianceFinalize' or 'correlationFinalize'. The fields are internal.
+ *
+ * The matrices are symmetric, so only the upper triangle is stored, row by row:
+ * element (i, j) with i <= j lives at 'packedIndex(i, j, cols)', and a matrix takes
+ * cols * (cols + 1) / 2 floats.
+ */
+typedef struct dmlCovariance
+{
+    int cols;
+    long count;
+    dmlAccum_t *mean;
+    dmlAccum_t *comoment;
+    float *block;
+    int blockRows;
+} dmlCovariance_t;
+
+/**
+ * @brief How 'buildBins' places the bin edges of a column.
+ *
+ * DML_BIN_WIDTH splits [min, max] into bins of equal width. DML_BIN_QUANTILE puts roughly
+ * the same number of values into every bin, with edges at the exact quantiles of the column.
+ */
+typedef enum dmlBinMode
+{
+    DML_BIN_WIDTH,
+    DML_BIN_QUANTILE
+} dmlBinMode;
+
+/* Largest number of bins, so that every bin code fits in a 'uint8_t'. */
+#define DML_MAX_BINS 256
+
+/**
+ * @brief Bin edges and histogram of one column, filled by 'buildBins'.
+ *
+ * Bin 'b' holds the values in [edges[b], edges[b + 1]); the first and the last bin also
+ * catch everything below 'edges[0]' and above 'edges[numBins]'. Release it with 'freeBins'.
+ */
+typedef struct dmlBins
+{
+    dmlBinMode mode;
+    int numBins;
+    float *edges;
+    int *counts;
+} dmlBins_t;
+
 void head(csvData_t *df, int lines);
 void tail(csvData_t *df, int lines);
+void writeToFile(void *context, const char *text, size_t len);
+void writerInit(dmlWriter_t *writer, dmlWriteFn write, void *context, char *buffer, int bufferSize);
+void writerFlush(dmlWriter_t *writer);
+void writerPut(dmlWriter_t *writer, const char *text, int len);
+int formatFloat(char *out, float value, int decimals);
+void writerPutFloat(dmlWriter_t *writer, float value, int width, int decimals);
+void writeRows(dmlWriter_t *writer, csvData_t *df, int firstRow, int numRows, const int *cols, int ncols, int decimals);
+void headTo(dmlWriter_t *writer, csvData_t *df, int lines, const int *cols, int ncols, int decimals);
+void tailTo(dmlWriter_t *writer, csvData_t *df, int lines, const int *cols, int ncols, int decimals);
+int describe(csvData_t *df, dmlSummary_t *out);
+void printSummary(const dmlSummary_t *summary, int cols);
+int profileSnapshot(dmlProfileEntry_t *out, int maxEntries);
+void profileReset(void);
+const char *profileTickUnit(void);
+void profileTo(dmlWriter_t *writer);
+void printProfile(void);
+void rngSeed(dmlRng_t *rng, uint32_t seed);
+uint32_t rngNext(dmlRng_t *rng);
+uint32_t rngBounded(dmlRng_t *rng, uint32_t bound);
+float rngUniform(dmlRng_t *rng);
 float *randomDataStream(csvData_t *df, int numOfData);
+float *randomDataStreamRng(csvData_t *df, int numOfData, dmlRng_t *rng);
+void partialShuffle(int *indices, int len, int count, dmlRng_t *rng);
+int *sampleRows(csvData_t *df, int sampleSize, dmlRng_t *rng);
+void reservoirInit(dmlReservoir_t *reservoir, int *buffer, int capacity);
+int reservoirOffer(dmlReservoir_t *reservoir, dmlRng_t *rng);
+int *stratifiedSample(csvData_t *df, int labelCol, float fraction, int *sampleSize, dmlRng_t *rng);
+int batchIterInit(dmlBatchIter_t *iter, csvData_t *df, int batchSize, float *buffer, int shuffle, dmlRng_t *rng);
+int batchIterNext(dmlBatchIter_t *iter, dmlBatch_t *batch);
+void batchIterReset(dmlBatchIter_t *iter);
+void batchIterFree(dmlBatchIter_t *iter);
+void setAllocator(const dmlAllocator_t *allocator);
+void freeVector(void *block);
+void arenaInit(dmlArena_t *arena, void *buffer, size_t capacity);
+void *arenaAlloc(dmlArena_t *arena, size_t size);
+void arenaFree(dmlArena_t *arena, void *block);
+size_t arenaMark(const dmlArena_t *arena);
+void arenaReset(dmlArena_t *arena, size_t mark);
+void useArena(dmlArena_t *arena);
+#if defined(DML_NO_HEAP)
+dmlArena_t *staticArena(void);
+#endif
 float *createFloatVector(int len);
+const char *simdBackend(void);
+float sumVector(const float *vector, int vectorLen);
+float sumOfSquaresVector(const float *vector, int vectorLen);
+void minMaxVector(const float *vector, int vectorLen, float *minOut, float *maxOut);
+float distanceL2(const float *a, const float *b, int len);
+float distanceL1(const float *a, const float *b, int len);
+float distanceCosine(const float *a, const float *b, int len);
+void distancesToRows(csvData_t *df, const float *query, dmlMetric metric, float *out);
+int pairwiseDistances(const csvData_t *a, const csvData_t *b, dmlMetric metric, float *out);
 float mean(csvData_t *df, int col);
 int compareVectors(const void *a, const void *b);
+int topK(const float *vector, int vectorLen, int k, int *idxOut, float *valOut);
+int topKLargest(const float *vector, int vectorLen, int k, int *idxOut, float *valOut);
 float median(csvData_t *df, int col);
+float quantile(csvData_t *df, int col, float p);
+int medianAll(csvData_t *df, const int *cols, int ncols, float *out);
+int quantileMatrix(csvData_t *df, const int *cols, int ncols, const float *ps, int nps, float *out);
 float standardDeviation(csvData_t *df, int col);
+void columnStats(csvData_t *df, int col, dmlStats_t *out);
+int columnStatsAll(csvData_t *df, dmlStats_t *out, int numThreads);
+long packedIndex(int i, int j, int cols);
+int covarianceInit(dmlCovariance_t *cov, int cols);
+void covarianceUpdate(dmlCovariance_t *cov, const float *row);
+void covarianceUpdateRows(dmlCovariance_t *cov, const float *rows, int numRows);
+void covarianceMerge(dmlCovariance_t *into, dmlCovariance_t *other);
+void covarianceFinalize(dmlCovariance_t *cov, float *out);
+void correlationFinalize(dmlCovariance_t *cov, float *out);
+void freeCovariance(dmlCovariance_t *cov);
+int covarianceMatrix(csvData_t *df, float *out, int numThreads);
+int correlationMatrix(csvData_t *df, float *out, int numThreads);
+void runningStatsInit(dmlRunningStats_t *stats);
+void runningStatsUpdate(dmlRunningStats_t *stats, float value);
+void runningStatsMerge(dmlRunningStats_t *into, const dmlRunningStats_t *other);
+void runningStatsFinalize(const dmlRunningStats_t *stats, dmlStats_t *out);
+void quantileSketchInit(dmlQuantileSketch_t *sketch);
+void quantileSketchPush(dmlQuantileSketch_t *sketch, float value);
+float quantileSketchQuery(const dmlQuantileSketch_t *sketch, float p);
+int buildBins(csvData_t *df, int col, int numBins, dmlBinMode mode, dmlBins_t *out);
+void freeBins(dmlBins_t *bins);
+void binCodes(const dmlBins_t *bins, const float *vector, int vectorLen, uint8_t *codes);
+void binColumn(csvData_t *df, int col, const dmlBins_t *bins, uint8_t *codes);
+dmlColumnar_t toColumnar(csvData_t *df);
+void columnarToFrame(const dmlColumnar_t *view, csvData_t *df);
+float *columnarColumn(const dmlColumnar_t *view, int col);
+void freeColumnar(dmlColumnar_t *view);
+int attachColumnar(csvData_t *df, const dmlColumnar_t *view);
+void detachColumnar(csvData_t *df);
+int attachStatsCache(csvData_t *df, dmlStatsCache_t *cache);
+void detachStatsCache(csvData_t *df);
+void invalidateStatsCache(csvData_t *df, int col);
+size_t csvReadFile(void *context, char *buffer, size_t size);
+void csvStreamInit(dmlCsvStream_t *stream, dmlReadFn read, void *context, char *buffer, int bufferSize, int hasHeader);
+int csvStreamReadRows(dmlCsvStream_t *stream, float *block, int maxRows, int cols);
+long streamStats(dmlCsvStream_t *stream, int cols, float *block, int blockRows, dmlRunningStats_t *stats, dmlQuantileSketch_t *sketches);
+long pipelineBlocks(dmlBlockReadFn read, void *readContext, int cols, float *ring, int blockRows, int numBlocks, dmlBlockFn consume, void *consumeContext);
+long streamStatsPipelined(dmlCsvStream_t *stream, int cols, float *ring, int blockRows, int numBlocks, dmlRunningStats_t *stats, dmlQuantileSketch_t *sketches);
 float *scaleToUnity(float *vector, int vectorLen, float lowerBound, float upperBound);
 float *scaleVector(float *vector, int vectorLen, float lowerBound, float upperBound, float newLowBound, float newUpBound);
+void scaleToUnityInto(const float *in, float *out, int vectorLen, float lowerBound, float upperBound);
+void scaleVectorInto(const float *in, float *out, int vectorLen, float lowerBound, float upperBound, float newLowBound, float newUpBound);
+dmlVectorView_t vectorView(float *vector, int len);
+dmlVectorView_t stridedView(float *base, int len, long stride);
+dmlVectorView_t columnView(csvData_t *df, int col);
+float sumView(const dmlVectorView_t *view);
+float sumOfSquaresView(const dmlVectorView_t *view);
+void minMaxView(const dmlVectorView_t *view, float *minOut, float *maxOut);
+void scaleViewInto(const dmlVectorView_t *in, const dmlVectorView_t *out, float lowerBound, float upperBound, float newLowBound, float newUpBound);
+void scaleToUnityViewInto(const dmlVectorView_t *in, const dmlVectorView_t *out, float lowerBound, float upperBound);
+void gatherView(const dmlVectorView_t *view, float *dst);
+int sliceFrame(csvData_t *df, int firstRow, int numRows, int firstCol, int numCols, float **rowPointers, csvData_t *out);
+int normalizeFrame(csvData_t *df, dmlNormMode mode, dmlNormParams_t *params);
+void applyNormalization(csvData_t *df, const dmlNormParams_t *params);
+void applyNormalizationRow(float *row, const dmlNormParams_t *params);
+void freeNormParams(dmlNormParams_t *params);
+#if DML_FIXED_COLS > 0
+int fixedNormFromParams(const dmlNormParams_t *params, dmlFixedNorm_t *out);
+void fixedNormalizeRow(const float *in, float *out, const dmlFixedNorm_t *norm);
+void fixedApplyNormalization(dmlFixedRow_t *rows, int numRows, const dmlFixedNorm_t *norm);
+float fixedDistance(const float *a, const float *b, dmlMetric metric);
+void fixedDistancesToRows(const dmlFixedFrame_t *frame, const float *query, dmlMetric metric, float *out);
+void fixedStatsUpdate(dmlRunningStats_t *stats, const float *row);
+void fixedFrameStats(const dmlFixedFrame_t *frame, dmlStats_t *out);
+#endif
+int writeBinaryFrame(csvData_t *df, const char *fileName, int withStats);
+int mapBinaryFrame(const char *fileName, dmlBinaryFrame_t *out);
+void unmapBinaryFrame(dmlBinaryFrame_t *bin);
+int binaryFrameAsCsv(dmlBinaryFrame_t *bin, csvData_t *out);
+int quantizeColumn(csvData_t *df, int col, dmlQuantType type, dmlQuantColumn_t *out);
+void freeQuantColumn(dmlQuantColumn_t *column);
+void dequantizeInto(const dmlQuantColumn_t *column, float *out);
+void quantColumnStats(const dmlQuantColumn_t *column, dmlQuantStats_t *out);
+void quantStatsToReal(const dmlQuantColumn_t *column, const dmlQuantStats_t *stats, dmlStats_t *out);
+void quantScaleInto(const dmlQuantColumn_t *column, int16_t *out, int32_t lowerBound, int32_t upperBound, int16_t newLowBound, int16_t newUpBound);
 
 
 #endif //DML_DML_H